@@ -0,0 +1,39 @@
+#!/bin/bash
+
+# Compare the error in the potential when the boundary conditions are
+# computed with the exact direct sum (gravity.direct_sum_bcs = 1) and
+# with the block-clustered direct sum (gravity.direct_sum_bcs = 2).
+# The two errors should agree to within the accuracy set by
+# gravity.direct_sum_theta: the script fails if they differ by more
+# than a relative tolerance TOL (which may be set in the environment).
+
+EXEC=./Castro3d.gnu.ex
+
+TOL=${TOL:-0.05}
+
+status=0
+
+for ncell in 16 32 64; do
+
+    ${EXEC} inputs amr.n_cell=${ncell} ${ncell} ${ncell} gravity.direct_sum_bcs=1 gravity.v=1 amr.plot_file=cube_direct_plt_${ncell}_ &> cube_direct_${ncell}.out
+    error_direct=$(grep "Error" cube_direct_${ncell}.out | awk '{print $3}')
+    time_direct=$(grep "fill_direct_sum_BCs() time" cube_direct_${ncell}.out | head -1 | awk '{print $4}')
+
+    ${EXEC} inputs amr.n_cell=${ncell} ${ncell} ${ncell} gravity.direct_sum_bcs=2 gravity.v=1 amr.plot_file=cube_block_plt_${ncell}_ &> cube_block_${ncell}.out
+    error_block=$(grep "Error" cube_block_${ncell}.out | awk '{print $3}')
+    time_block=$(grep "fill_block_direct_sum_BCs() time" cube_block_${ncell}.out | head -1 | awk '{print $4}')
+
+    echo "ncell = ${ncell} direct sum error = ${error_direct} (time ${time_direct}), block error = ${error_block} (time ${time_block})"
+
+    if [ -z "${error_direct}" ] || [ -z "${error_block}" ]; then
+        echo "ncell = ${ncell}: run failed"
+        status=1
+    elif ! awk -v d="${error_direct}" -v b="${error_block}" -v tol="${TOL}" \
+             'BEGIN {diff = b - d; if (diff < 0) diff = -diff; exit !(diff <= tol * d)}'; then
+        echo "ncell = ${ncell}: the errors differ by more than a relative tolerance of ${TOL}"
+        status=1
+    fi
+
+done
+
+exit ${status}
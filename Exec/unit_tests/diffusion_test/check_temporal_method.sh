@@ -0,0 +1,41 @@
+#!/bin/bash
+
+# Run the diffusion test with RKL2 super-time-stepping
+# (diffusion.temporal_method = 1) and with backward Euler (2), at a
+# timestep several times the explicit diffusion limit, and check the
+# error against the analytic solution.  An unstable integration gives an
+# error of order the amplitude of the pulse (1).
+#
+# usage: ./check_temporal_method.sh executable inputs
+
+EXEC=$1
+INPUTS=$2
+
+# RKL2 is second order in time, backward Euler only first order
+tolerance=(0 5.e-3 3.e-2)
+
+status=0
+
+for method in 1 2; do
+
+    ${EXEC} ${INPUTS} diffusion.temporal_method=${method} castro.fixed_dt=1.e-4 \
+            amr.plot_int=-1 amr.check_int=-1 &> diffusion_method_${method}.out
+
+    error=$(grep "L-inf error against analytic solution" diffusion_method_${method}.out | awk '{print $NF}')
+
+    if [ -z "${error}" ]; then
+        echo "temporal_method = ${method}: run failed"
+        status=1
+        continue
+    fi
+
+    if awk -v e="${error}" -v tol="${tolerance[${method}]}" 'BEGIN {exit !(e <= tol)}'; then
+        echo "temporal_method = ${method}: L-inf error = ${error} (tolerance ${tolerance[${method}]})"
+    else
+        echo "temporal_method = ${method}: L-inf error = ${error} exceeds tolerance ${tolerance[${method}]}"
+        status=1
+    fi
+
+done
+
+exit ${status}
@@ -0,0 +1,646 @@
+/* Implementations of functions in Problem.H go here */
+
+#include <Castro.H>
+
+#include <AMReX_ParallelDescriptor.H>
+
+#include <prob_parameters.H>
+
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+#ifdef AMREX_USE_OMP
+#include <omp.h>
+#endif
+
+#if defined(RADIATION) || defined(MHD)
+#error "the hydro kernel benchmark only supports pure hydrodynamics"
+#endif
+
+using namespace amrex;
+
+namespace {
+
+    struct bench_result {
+        std::string name;
+        Long zones;
+        Real time_min;
+        Real time_avg;
+        Real bytes;
+    };
+
+    // Divide a box (cell-centered or nodal) into disjoint tiles, so
+    // that on CPUs we can thread over the tiles the same way the
+    // MFIter loop in construct_ctu_hydro_source does.
+
+    Vector<Box> make_tiles (const Box& bx, const IntVect& tile_size)
+    {
+        IntVect ntiles;
+        Long ntot = 1;
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            ntiles[dir] = (bx.length(dir) + tile_size[dir] - 1) / tile_size[dir];
+            ntot *= ntiles[dir];
+        }
+
+        Vector<Box> tiles;
+        tiles.reserve(ntot);
+
+        for (Long t = 0; t < ntot; ++t) {
+            Long rem = t;
+            IntVect lo, hi;
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                const int it = static_cast<int>(rem % ntiles[dir]);
+                rem /= ntiles[dir];
+                lo[dir] = bx.smallEnd(dir) + it * tile_size[dir];
+                hi[dir] = amrex::min(lo[dir] + tile_size[dir] - 1, bx.bigEnd(dir));
+            }
+            tiles.push_back(Box(lo, hi, bx.ixType()));
+        }
+
+        return tiles;
+    }
+
+    // Time a kernel that operates on the zones (or interfaces) of
+    // region.  The kernel is called once to warm up and then nrep
+    // times; we record the fastest and the average of the timed calls.
+    // bytes is the compulsory memory traffic of one call: every array
+    // the kernel reads or writes, touched once per zone.
+
+    template <typename F>
+    bench_result time_kernel (const std::string& name, const Box& region,
+                              Real bytes, const IntVect& tile_size, F&& kernel)
+    {
+        const Vector<Box> tiles = make_tiles(region, tile_size);
+        const int ntiles = static_cast<int>(tiles.size());
+
+        auto run = [&] ()
+        {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (int t = 0; t < ntiles; ++t) {
+                kernel(tiles[t]);
+            }
+            Gpu::streamSynchronize();
+        };
+
+        run();
+
+        const int nrep = amrex::max(problem::bench_nrep, 1);
+
+        Real time_min = std::numeric_limits<Real>::max();
+        Real time_tot = 0.0_rt;
+
+        for (int rep = 0; rep < nrep; ++rep) {
+            const Real strt = ParallelDescriptor::second();
+            run();
+            const Real elapsed = ParallelDescriptor::second() - strt;
+            time_min = amrex::min(time_min, elapsed);
+            time_tot += elapsed;
+        }
+
+        ParallelDescriptor::ReduceRealMax(time_min);
+        ParallelDescriptor::ReduceRealMax(time_tot);
+
+        return {name, region.numPts(), time_min, time_tot / nrep, bytes};
+    }
+
+}
+
+void Castro::problem_post_init()
+{
+    BL_PROFILE("Castro::problem_post_init()");
+
+    // Build a synthetic box of bench_ncell zones on a side (plus the
+    // ghost cells the CTU hydro needs), fill it with a smooth, subsonic
+    // flow, and then time each of the main hydro kernels on it in the
+    // order they are called in construct_ctu_hydro_source.  The data
+    // each kernel consumes is produced by running the preceding kernels
+    // once before the timing starts.
+
+    const int n = problem::bench_ncell;
+
+    const Box bx(IntVect(AMREX_D_DECL(0, 0, 0)), IntVect(AMREX_D_DECL(n-1, n-1, n-1)));
+    const Box qbx = amrex::grow(bx, NUM_GROW);
+    const Box obx = amrex::grow(bx, 1);
+
+#ifdef AMREX_USE_GPU
+    // On GPUs each kernel is launched once over the whole region.
+    const IntVect tile_size(AMREX_D_DECL(std::numeric_limits<int>::max(),
+                                         std::numeric_limits<int>::max(),
+                                         std::numeric_limits<int>::max()));
+#else
+    const IntVect tile_size(AMREX_D_DECL(problem::bench_tile_size,
+                                         problem::bench_tile_size,
+                                         problem::bench_tile_size));
+#endif
+
+    const Real time = state[State_Type].curTime();
+    const auto dx = geom.CellSizeArray();
+
+    // the conserved state
+
+    FArrayBox U(qbx, NUM_STATE);
+    U.setVal<RunOn::Device>(0.0_rt);
+    auto const U_arr = U.array();
+
+    const Real length = static_cast<Real>(n) * dx[0];
+
+    amrex::ParallelFor(qbx,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        const Real kx = 2.0_rt * M_PI / length;
+
+        Real sx = std::sin(kx * (static_cast<Real>(i) + 0.5_rt) * dx[0]);
+        Real sy = 1.0_rt;
+        Real sz = 1.0_rt;
+#if AMREX_SPACEDIM >= 2
+        sy = std::sin(kx * (static_cast<Real>(j) + 0.5_rt) * dx[1]);
+#endif
+#if AMREX_SPACEDIM == 3
+        sz = std::sin(kx * (static_cast<Real>(k) + 0.5_rt) * dx[2]);
+#endif
+
+        eos_t eos_state;
+
+        eos_state.rho = problem::dens0 * (1.0_rt + problem::pert_amp * sx * sy * sz);
+        eos_state.T = problem::temp0 * (1.0_rt - problem::pert_amp * sx * sy);
+        for (int nn = 0; nn < NumSpec; nn++) {
+            eos_state.xn[nn] = 1.0_rt / static_cast<Real>(NumSpec);
+        }
+#ifdef AUX_THERMO
+        set_aux_comp_from_X(eos_state);
+#endif
+
+        eos(eos_input_rt, eos_state);
+
+        const Real u = problem::mach * eos_state.cs * sy;
+        const Real v = problem::mach * eos_state.cs * sz;
+        const Real w = problem::mach * eos_state.cs * sx;
+
+        U_arr(i,j,k,URHO) = eos_state.rho;
+        U_arr(i,j,k,UMX) = eos_state.rho * u;
+        U_arr(i,j,k,UMY) = eos_state.rho * v;
+        U_arr(i,j,k,UMZ) = eos_state.rho * w;
+        U_arr(i,j,k,UEINT) = eos_state.rho * eos_state.e;
+        U_arr(i,j,k,UEDEN) = eos_state.rho * (eos_state.e + 0.5_rt * (u * u + v * v + w * w));
+        U_arr(i,j,k,UTEMP) = eos_state.T;
+        for (int nn = 0; nn < NumSpec; nn++) {
+            U_arr(i,j,k,UFS+nn) = eos_state.rho * eos_state.xn[nn];
+        }
+#ifdef AUX_THERMO
+        for (int nn = 0; nn < NumAux; nn++) {
+            U_arr(i,j,k,UFX+nn) = eos_state.rho * eos_state.aux[nn];
+        }
+#endif
+    });
+
+    // the primitive state and its inputs
+
+    FArrayBox rho_inv(qbx, 1);
+    auto const rho_inv_arr = rho_inv.array();
+
+    amrex::ParallelFor(qbx,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+    {
+        rho_inv_arr(i,j,k) = 1.0_rt / U_arr(i,j,k,URHO);
+    });
+
+    FArrayBox q(qbx, NQTHERM);
+    FArrayBox qaux(qbx, NQAUX);
+    auto const q_arr = q.array();
+    auto const qaux_arr = qaux.array();
+
+    ctoprim(qbx, time, U_arr, q_arr, qaux_arr);
+
+    FArrayBox src_q(qbx, NQSRC);
+    src_q.setVal<RunOn::Device>(0.0_rt);
+    auto const src_q_arr = src_q.const_array();
+
+    FArrayBox shk(obx, 1);
+    shk.setVal<RunOn::Device>(0.0_rt);
+    auto const shk_arr = shk.const_array();
+
+#if AMREX_SPACEDIM < 3
+    // Cartesian geometry, so there is no area change
+
+    FArrayBox dloga(qbx, 1);
+    dloga.setVal<RunOn::Device>(0.0_rt);
+    auto const dloga_arr = dloga.const_array();
+#endif
+
+    // a CFL-limited timestep for the synthetic data
+
+    ReduceOps<ReduceOpMax> reduce_op;
+    ReduceData<Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    reduce_op.eval(bx, reduce_data,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+    {
+        Real vmax = amrex::max(std::abs(q_arr(i,j,k,QU)),
+                               std::abs(q_arr(i,j,k,QV)),
+                               std::abs(q_arr(i,j,k,QW)));
+        return {qaux_arr(i,j,k,QC) + vmax};
+    });
+
+    const Real smax = amrex::get<0>(reduce_data.value());
+
+    Real dxmin = dx[0];
+    for (int dir = 1; dir < AMREX_SPACEDIM; ++dir) {
+        dxmin = amrex::min(dxmin, dx[dir]);
+    }
+
+    const Real dt = 0.5_rt * dxmin / smax;
+
+    // storage for the interface states, fluxes, and Godunov states
+
+    std::array<FArrayBox, AMREX_SPACEDIM> qm, qp, flux, qe;
+    std::array<Box, AMREX_SPACEDIM> nbx, cbx;
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        qm[dir].resize(obx, NQ);
+        qp[dir].resize(obx, NQ);
+
+        nbx[dir] = amrex::surroundingNodes(bx, dir);
+
+        // the first Riemann solve is done on the interfaces of the
+        // valid region plus one zone in the transverse directions,
+        // as in construct_ctu_hydro_source
+
+        IntVect ng(1);
+        ng[dir] = 0;
+        cbx[dir] = amrex::grow(nbx[dir], ng);
+
+        flux[dir].resize(amrex::grow(nbx[dir], 1), NUM_STATE);
+        qe[dir].resize(amrex::grow(nbx[dir], 1), NGDNV);
+        flux[dir].setVal<RunOn::Device>(0.0_rt);
+        qe[dir].setVal<RunOn::Device>(0.0_rt);
+    }
+
+    FArrayBox ql(obx, NQ), qr(obx, NQ);
+    auto const ql_arr = ql.array();
+    auto const qr_arr = qr.array();
+
+    Vector<bench_result> results;
+
+    constexpr Real rs = sizeof(Real);
+
+    // Interface state reconstruction and characteristic tracing.  Each
+    // call reads U (for the passives), 1/rho, q, qaux, and the sources,
+    // and writes the two interface states.
+
+    const Real trace_bytes = rs * static_cast<Real>(obx.numPts()) *
+                             (NUM_STATE + 1 + NQTHERM + NQAUX + NQSRC + 2 * NQ);
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        auto const qm_arr = qm[dir].array();
+        auto const qp_arr = qp[dir].array();
+
+        results.push_back(time_kernel("trace_plm_" + std::to_string(dir), obx, trace_bytes, tile_size,
+                                      [&] (const Box& tbx)
+                                      {
+                                          trace_plm(tbx, dir,
+                                                    U_arr, rho_inv_arr, q_arr, qaux_arr,
+                                                    qm_arr, qp_arr,
+#if AMREX_SPACEDIM < 3
+                                                    dloga_arr,
+#endif
+                                                    src_q_arr, bx, dt);
+                                      }));
+    }
+
+    // We do PPM last so the interface states used by the remaining
+    // kernels come from the default reconstruction.
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        auto const qm_arr = qm[dir].array();
+        auto const qp_arr = qp[dir].array();
+
+        results.push_back(time_kernel("trace_ppm_" + std::to_string(dir), obx, trace_bytes, tile_size,
+                                      [&] (const Box& tbx)
+                                      {
+                                          trace_ppm(tbx, dir,
+                                                    U_arr, rho_inv_arr, q_arr, qaux_arr, src_q_arr,
+                                                    qm_arr, qp_arr,
+#if AMREX_SPACEDIM < 3
+                                                    dloga_arr,
+#endif
+                                                    bx, dt);
+                                      }));
+    }
+
+    // The Riemann solvers, through the same interface the hydro uses.
+    // Each call reads the two interface states, qaux, and the shock
+    // flag and writes the flux and the Godunov state.  We leave the
+    // fluxes from the solver selected in the inputs in place for the
+    // kernels that follow.
+
+    const int riemann_solver_in = riemann_solver;
+    const int riemann_batched_in = riemann_batched;
+
+    const std::array<std::string, 3> solver_names = {"riemann_cgf", "riemann_cg", "riemann_hllc"};
+
+    riemann_batched = 0;
+
+    for (int solver = 0; solver < 3; ++solver) {
+
+        riemann_solver = solver;
+
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            auto const qm_arr = qm[dir].array();
+            auto const qp_arr = qp[dir].array();
+            auto const flux_arr = flux[dir].array();
+            auto const qe_arr = qe[dir].array();
+
+            const Real bytes = rs * static_cast<Real>(cbx[dir].numPts()) *
+                               (2 * NQ + NQAUX + 1 + NUM_STATE + NGDNV);
+
+            results.push_back(time_kernel(solver_names[solver] + "_" + std::to_string(dir), cbx[dir], bytes, tile_size,
+                                          [&] (const Box& tbx)
+                                          {
+                                              cmpflx_plus_godunov(tbx,
+                                                                  qm_arr, qp_arr,
+                                                                  flux_arr, qe_arr,
+                                                                  qaux_arr, shk_arr,
+                                                                  dir, false);
+                                          }));
+        }
+    }
+
+#if !defined(AMREX_USE_GPU) && !defined(HYBRID_MOMENTUM)
+    // The batched CGF solve (castro.riemann_batched = 1).  This must
+    // give exactly the same fluxes and Godunov state as the
+    // interface-by-interface solve, so we compare the two bit for bit
+    // and abort if they differ.
+
+    if (ppm_temp_fix != 2) {
+
+        riemann_solver = 0;
+
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            auto const qm_arr = qm[dir].array();
+            auto const qp_arr = qp[dir].array();
+            auto const flux_arr = flux[dir].array();
+            auto const qe_arr = qe[dir].array();
+
+            FArrayBox flux_ref(flux[dir].box(), NUM_STATE);
+            FArrayBox qe_ref(qe[dir].box(), NGDNV);
+            flux_ref.setVal<RunOn::Host>(0.0_rt);
+            qe_ref.setVal<RunOn::Host>(0.0_rt);
+            flux[dir].setVal<RunOn::Host>(0.0_rt);
+            qe[dir].setVal<RunOn::Host>(0.0_rt);
+
+            riemann_batched = 0;
+
+            cmpflx_plus_godunov(cbx[dir],
+                                qm_arr, qp_arr,
+                                flux_ref.array(), qe_ref.array(),
+                                qaux_arr, shk_arr,
+                                dir, false);
+
+            riemann_batched = 1;
+
+            const Real bytes = rs * static_cast<Real>(cbx[dir].numPts()) *
+                               (2 * NQ + NQAUX + 1 + NUM_STATE + NGDNV);
+
+            results.push_back(time_kernel("riemann_cgf_batched_" + std::to_string(dir), cbx[dir], bytes, tile_size,
+                                          [&] (const Box& tbx)
+                                          {
+                                              cmpflx_plus_godunov(tbx,
+                                                                  qm_arr, qp_arr,
+                                                                  flux_arr, qe_arr,
+                                                                  qaux_arr, shk_arr,
+                                                                  dir, false);
+                                          }));
+
+            auto const flux_ref_arr = flux_ref.const_array();
+            auto const qe_ref_arr = qe_ref.const_array();
+
+            Long nmismatch = 0;
+
+            amrex::LoopOnCpu(cbx[dir], NUM_STATE,
+            [&] (int i, int j, int k, int n) noexcept
+            {
+                if (flux_arr(i,j,k,n) != flux_ref_arr(i,j,k,n)) {
+                    nmismatch++;
+                }
+            });
+
+            amrex::LoopOnCpu(cbx[dir], NGDNV,
+            [&] (int i, int j, int k, int n) noexcept
+            {
+                if (qe_arr(i,j,k,n) != qe_ref_arr(i,j,k,n)) {
+                    nmismatch++;
+                }
+            });
+
+            if (nmismatch > 0) {
+                amrex::Error("riemann_batched = 1 differs from riemann_batched = 0 in " +
+                             std::to_string(nmismatch) + " values in direction " + std::to_string(dir));
+            }
+        }
+
+        amrex::Print() << "riemann_batched = 1 matches riemann_batched = 0 bit for bit" << std::endl;
+    }
+#endif
+
+    riemann_solver = riemann_solver_in;
+    riemann_batched = riemann_batched_in;
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        cmpflx_plus_godunov(cbx[dir],
+                            qm[dir].array(), qp[dir].array(),
+                            flux[dir].array(), qe[dir].array(),
+                            qaux_arr, shk_arr,
+                            dir, false);
+    }
+    Gpu::streamSynchronize();
+
+#if AMREX_SPACEDIM >= 2
+    // The transverse corrections.  trans_single adds the flux
+    // difference in one transverse direction to the interface states
+    // normal to dir; it reads the two states, qaux, the transverse
+    // flux and Godunov state, and writes the two corrected states.
+
+    const Real hdt = 0.5_rt * dt;
+
+#if AMREX_SPACEDIM == 2
+    FArrayBox area_x(amrex::grow(nbx[0], 1), 1), area_y(amrex::grow(nbx[1], 1), 1);
+    FArrayBox vol(obx, 1);
+    area_x.setVal<RunOn::Device>(dx[1]);
+    area_y.setVal<RunOn::Device>(dx[0]);
+    vol.setVal<RunOn::Device>(dx[0] * dx[1]);
+    const std::array<Array4<Real const>, 2> area_arr = {area_x.const_array(), area_y.const_array()};
+    auto const vol_arr = vol.const_array();
+#endif
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        const int dir_t = (dir + 1) % AMREX_SPACEDIM;
+
+#if AMREX_SPACEDIM == 2
+        const Box tbx_n = nbx[dir];
+        const Real cdtdx = hdt / dx[dir_t];
+#else
+        // grown in the direction that is neither normal nor transverse,
+        // as in construct_ctu_hydro_source
+        IntVect ng(0);
+        ng[3 - dir - dir_t] = 1;
+        const Box tbx_n = amrex::grow(nbx[dir], ng);
+        const Real cdtdx = dt / dx[dir_t] / 3.0_rt;
+#endif
+
+        auto const qm_arr = qm[dir].const_array();
+        auto const qp_arr = qp[dir].const_array();
+        auto const flux_t = flux[dir_t].const_array();
+        auto const q_t = qe[dir_t].const_array();
+
+        const Real bytes = rs * static_cast<Real>(tbx_n.numPts()) *
+                           (4 * NQ + NQAUX + NUM_STATE + NGDNV);
+
+        results.push_back(time_kernel("trans_single_" + std::to_string(dir), tbx_n, bytes, tile_size,
+                                      [&] (const Box& tbx)
+                                      {
+                                          trans_single(tbx, dir_t, dir,
+                                                       qm_arr, ql_arr,
+                                                       qp_arr, qr_arr,
+                                                       qaux_arr,
+                                                       flux_t, q_t,
+#if AMREX_SPACEDIM == 2
+                                                       area_arr[dir_t], vol_arr,
+#endif
+                                                       hdt, cdtdx);
+                                      }));
+    }
+#endif
+
+#if AMREX_SPACEDIM == 3
+    // trans_final adds the flux differences in both transverse
+    // directions to the normal interface states.
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        const int dir_t1 = (dir + 1) % 3;
+        const int dir_t2 = (dir + 2) % 3;
+
+        const int t1 = amrex::min(dir_t1, dir_t2);
+        const int t2 = amrex::max(dir_t1, dir_t2);
+
+        auto const qm_arr = qm[dir].const_array();
+        auto const qp_arr = qp[dir].const_array();
+        auto const flux_t1 = flux[t1].const_array();
+        auto const flux_t2 = flux[t2].const_array();
+        auto const q_t1 = qe[t1].const_array();
+        auto const q_t2 = qe[t2].const_array();
+
+        const Real hdtdt1 = hdt / dx[t1];
+        const Real hdtdt2 = hdt / dx[t2];
+
+        const Real bytes = rs * static_cast<Real>(nbx[dir].numPts()) *
+                           (4 * NQ + NQAUX + 2 * NUM_STATE + 2 * NGDNV);
+
+        results.push_back(time_kernel("trans_final_" + std::to_string(dir), nbx[dir], bytes, tile_size,
+                                      [&] (const Box& tbx)
+                                      {
+                                          trans_final(tbx, dir, t1, t2,
+                                                      qm_arr, ql_arr,
+                                                      qp_arr, qr_arr,
+                                                      qaux_arr,
+                                                      flux_t1, flux_t2,
+                                                      q_t1, q_t2,
+                                                      hdtdt1, hdtdt2);
+                                      }));
+    }
+#endif
+
+    // The conservative update.  This reads and writes the state and
+    // reads the fluxes and Godunov states on all of the faces.
+
+    {
+        FArrayBox U_new(bx, NUM_STATE);
+        U_new.copy<RunOn::Device>(U, bx);
+        auto const U_new_arr = U_new.array();
+
+        auto const flux0_arr = flux[0].array();
+        auto const qx_arr = qe[0].const_array();
+#if AMREX_SPACEDIM >= 2
+        auto const flux1_arr = flux[1].array();
+        auto const qy_arr = qe[1].const_array();
+#endif
+#if AMREX_SPACEDIM == 3
+        auto const flux2_arr = flux[2].array();
+        auto const qz_arr = qe[2].const_array();
+#endif
+
+        const Real bytes = rs * static_cast<Real>(bx.numPts()) *
+                           (2 * NUM_STATE + AMREX_SPACEDIM * (NUM_STATE + NGDNV));
+
+        results.push_back(time_kernel("consup_hydro", bx, bytes, tile_size,
+                                      [&] (const Box& tbx)
+                                      {
+                                          consup_hydro(tbx,
+#ifdef SHOCK_VAR
+                                                       shk_arr,
+#endif
+                                                       U_new_arr,
+                                                       flux0_arr, qx_arr,
+#if AMREX_SPACEDIM >= 2
+                                                       flux1_arr, qy_arr,
+#endif
+#if AMREX_SPACEDIM == 3
+                                                       flux2_arr, qz_arr,
+#endif
+                                                       dt);
+                                      }));
+    }
+
+    // Report the results, and write them out in a form that can be
+    // compared against a stored baseline with compare_bench.py.
+
+    int nthreads = 1;
+#ifdef AMREX_USE_OMP
+    nthreads = omp_get_max_threads();
+#endif
+
+    amrex::Print() << std::endl
+                   << "hydro kernel benchmark: " << AMREX_SPACEDIM << "-d, "
+                   << n << " zones per side, NQ = " << NQ
+                   << ", NumSpec = " << NumSpec
+                   << ", threads = " << nthreads << std::endl << std::endl;
+
+    amrex::Print() << std::setw(20) << std::left << "kernel"
+                   << std::setw(16) << std::right << "time (s)"
+                   << std::setw(16) << "zones/s"
+                   << std::setw(16) << "GB/s" << std::endl;
+
+    for (const auto& r : results) {
+        amrex::Print() << std::setw(20) << std::left << r.name
+                       << std::setw(16) << std::right << std::setprecision(6) << r.time_min
+                       << std::setw(16) << static_cast<Real>(r.zones) / r.time_min
+                       << std::setw(16) << r.bytes / r.time_min / 1.e9_rt << std::endl;
+    }
+
+    if (ParallelDescriptor::IOProcessor()) {
+        std::ofstream out(problem::bench_file);
+        out << std::setprecision(10);
+
+        out << "# dim " << AMREX_SPACEDIM << "\n";
+        out << "# ncell " << n << "\n";
+        out << "# NQ " << NQ << "\n";
+        out << "# NumSpec " << NumSpec << "\n";
+        out << "# nthreads " << nthreads << "\n";
+        out << "# nranks " << ParallelDescriptor::NProcs() << "\n";
+        out << "# kernel zones time_min time_avg zones_per_sec bytes bytes_per_sec\n";
+
+        for (const auto& r : results) {
+            out << r.name << " "
+                << r.zones << " "
+                << r.time_min << " "
+                << r.time_avg << " "
+                << static_cast<Real>(r.zones) / r.time_min << " "
+                << r.bytes << " "
+                << r.bytes / r.time_min << "\n";
+        }
+    }
+}
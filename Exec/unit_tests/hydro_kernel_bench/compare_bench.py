@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+
+"""Compare the output of the hydro kernel benchmark against a
+baseline, flagging any kernel whose throughput dropped by more than
+the tolerance."""
+
+import argparse
+import sys
+
+
+def read_bench(filename):
+    """Return the header values and a dict of kernel name -> zones/sec."""
+
+    header = {}
+    results = {}
+
+    with open(filename) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+
+            if line.startswith("#"):
+                fields = line[1:].split()
+                if len(fields) == 2:
+                    header[fields[0]] = fields[1]
+                continue
+
+            fields = line.split()
+            results[fields[0]] = float(fields[4])
+
+    return header, results
+
+
+def main():
+
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="benchmark output to compare against")
+    parser.add_argument("new", help="new benchmark output")
+    parser.add_argument("--tol", type=float, default=0.1,
+                        help="allowed fractional drop in throughput")
+    args = parser.parse_args()
+
+    base_header, base = read_bench(args.baseline)
+    new_header, new = read_bench(args.new)
+
+    for key in sorted(set(base_header) | set(new_header)):
+        if base_header.get(key) != new_header.get(key):
+            print(f"warning: {key} differs: {base_header.get(key)} vs. {new_header.get(key)}")
+
+    failed = False
+
+    print(f"{'kernel':20} {'baseline zones/s':>18} {'new zones/s':>18} {'change':>10}")
+
+    for name, base_rate in base.items():
+        if name not in new:
+            print(f"{name:20} {base_rate:18.6g} {'missing':>18}")
+            continue
+
+        change = new[name] / base_rate - 1.0
+        flag = ""
+        if change < -args.tol:
+            flag = "  <-- regression"
+            failed = True
+
+        print(f"{name:20} {base_rate:18.6g} {new[name]:18.6g} {100.0 * change:9.1f}%{flag}")
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -12,13 +12,17 @@ Castro::construct_old_diff_source(MultiFab& source, MultiFab& state_in, Real tim
 {
     BL_PROFILE("Castro::construct_old_diff_source()");
 
-    amrex::ignore_unused(dt);
-
     const Real strt_time = ParallelDescriptor::second();
 
     MultiFab TempDiffTerm(grids, dmap, 1, 0);
 
-    add_temp_diffusion_to_source(source, state_in, TempDiffTerm, time);
+    if (diffusion::temporal_method == 0) {
+        add_temp_diffusion_to_source(source, state_in, TempDiffTerm, time);
+    } else {
+        // The diffusion over the whole step is integrated here, from
+        // the old state, and applied as a constant source.
+        add_temp_diffusion_update_to_source(source, state_in, TempDiffTerm, time, dt);
+    }
 
     if (verbose > 1)
     {
@@ -42,6 +46,13 @@ Castro::construct_new_diff_source(MultiFab& source, MultiFab& state_old, MultiFa
 {
     BL_PROFILE("Castro::construct_new_diff_source()");
 
+    // With super-time-stepping or the implicit update, the old-time
+    // source already accounts for the diffusion over the whole step.
+
+    if (diffusion::temporal_method != 0) {
+        return;
+    }
+
     const Real strt_time = ParallelDescriptor::second();
 
     MultiFab TempDiffTerm(grids, dmap, 1, 0);
@@ -94,19 +105,80 @@ Castro::add_temp_diffusion_to_source (MultiFab& ext_src, MultiFab& state_in, Mul
 }
 
 
+void
+Castro::add_temp_diffusion_update_to_source (MultiFab& ext_src, MultiFab& state_in, MultiFab& DiffTerm, Real t, Real dt)
+{
+    BL_PROFILE("Castro::add_temp_diffusion_update_to_source()");
+
+    DiffTerm.setVal(0.);
+    if (diffuse_temp == 1) {
+        getTempDiffusionUpdate(t, dt, state_in, DiffTerm);
+
+        MultiFab::Saxpy(ext_src,1.0,DiffTerm,0,UEDEN,1,0);
+        MultiFab::Saxpy(ext_src,1.0,DiffTerm,0,UEINT,1,0);
+    }
+}
+
+
 void
 Castro::getTempDiffusionTerm (Real time, MultiFab& state_in, MultiFab& TempDiffTerm)
 {
     BL_PROFILE("Castro::getTempDiffusionTerm()");
 
-   // Fill coefficients at this level.
    Vector<std::unique_ptr<MultiFab> > coeffs(AMREX_SPACEDIM);
+   MultiFab Temperature;
+   MultiFab CrseTemp;
+
+   fillTempDiffusionData(time, state_in, Temperature, CrseTemp, coeffs);
+
+   diffusion->applyop(level, Temperature, CrseTemp, TempDiffTerm, coeffs);
+
+}
+
+
+void
+Castro::getTempDiffusionUpdate (Real time, Real dt, MultiFab& state_in, MultiFab& TempDiffTerm)
+{
+    BL_PROFILE("Castro::getTempDiffusionUpdate()");
+
+   Vector<std::unique_ptr<MultiFab> > coeffs(AMREX_SPACEDIM);
+   MultiFab Temperature;
+   MultiFab CrseTemp;
+   MultiFab rho_cv(grids, dmap, 1, 0);
+
+   fillTempDiffusionData(time, state_in, Temperature, CrseTemp, coeffs, &rho_cv);
+
+   MultiFab DeltaT(grids, dmap, 1, 0);
+
+   if (diffusion::temporal_method == 1) {
+       diffusion->integrate_rkl2(level, Temperature, CrseTemp, rho_cv, coeffs, dt, DeltaT);
+   } else {
+       diffusion->solve_backward_euler(level, Temperature, CrseTemp, rho_cv, coeffs, dt, DeltaT);
+   }
+
+   // The energy source that gives this temperature change over dt.
+
+   MultiFab::Copy(TempDiffTerm, DeltaT, 0, 0, 1, 0);
+   MultiFab::Multiply(TempDiffTerm, rho_cv, 0, 0, 1, 0);
+   TempDiffTerm.mult(1.0_rt / dt);
+
+}
+
+
+void
+Castro::fillTempDiffusionData (Real time, MultiFab& state_in, MultiFab& Temperature, MultiFab& CrseTemp,
+                               Vector<std::unique_ptr<MultiFab> >& coeffs, MultiFab* rho_cv)
+{
+    BL_PROFILE("Castro::fillTempDiffusionData()");
+
+   // Fill coefficients at this level.
+   coeffs.resize(AMREX_SPACEDIM);
    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
        coeffs[dir] = std::make_unique<MultiFab>(getEdgeBoxArray(dir), dmap, 1, 0);
    }
 
    // Fill temperature at this level.
-   MultiFab Temperature(grids, dmap, 1, 1);
+   Temperature.define(grids, dmap, 1, 1);
 
    {
        FillPatchIterator fpi(*this, state_in, 1, time, State_Type, 0, NUM_STATE);
@@ -137,6 +209,10 @@ Castro::getTempDiffusionTerm (Real time, MultiFab& state_in, MultiFab& TempDiffT
 
                fill_temp_cond(obx, U_arr, coeff_arr);
 
+               if (rho_cv != nullptr) {
+                   fill_temp_rho_cv(bx, U_arr, rho_cv->array(mfi));
+               }
+
                for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
 
                    const Box& nbx = amrex::surroundingNodes(bx, idir);
@@ -160,8 +236,6 @@ Castro::getTempDiffusionTerm (Real time, MultiFab& state_in, MultiFab& TempDiffT
 
    }
 
-   MultiFab CrseTemp;
-
    if (level > 0) {
        // Fill temperature at next coarser level, if it exists.
        const BoxArray& crse_grids = getLevel(level-1).boxArray();
@@ -170,6 +244,4 @@ Castro::getTempDiffusionTerm (Real time, MultiFab& state_in, MultiFab& TempDiffT
        FillPatch(getLevel(level-1),CrseTemp,1,time,State_Type,UTEMP,1);
    }
 
-   diffusion->applyop(level, Temperature, CrseTemp, TempDiffTerm, coeffs);
-
 }
@@ -16,7 +16,9 @@ Diffusion::Diffusion(Amr* Parent, BCRec* _phys_bc)
     grids(MAX_LEV),
     volume(MAX_LEV),
     area(MAX_LEV),
-    phys_bc(_phys_bc)
+    phys_bc(_phys_bc),
+    apply_ops(MAX_LEV),
+    implicit_ops(MAX_LEV)
 {
     AMREX_ALWAYS_ASSERT(parent->maxLevel() < MAX_LEV);
 
@@ -49,6 +51,20 @@ Diffusion::install_level (int                   level,
 
     BoxArray ba(LevelData[level]->boxArray());
     grids[level] = ba;
+
+    // The grids at this level may have changed, so the cached operators
+    // will be rebuilt when they are next used.
+    clear_operators(level);
+}
+
+void
+Diffusion::clear_operators (int level)
+{
+    for (auto* cache : {&apply_ops, &implicit_ops}) {
+        auto& c = (*cache)[level];
+        c.mlmg.reset();
+        c.op.reset();
+    }
 }
 
 void
@@ -137,33 +153,263 @@ Diffusion::applyop_mlmg (int level, MultiFab& Temperature,
         std::cout << "... compute diffusive term at level " << level << '\n';
     }
 
-    const Geometry& geom = parent->Geom(level);
+    MLMG& mlmg = get_temp_op(apply_ops, level, 0.0, -1.0, Temperature, CrseTemp, temp_cond_coef);
+    mlmg.apply({&DiffTerm}, {&Temperature});
+}
+
+MLMG&
+Diffusion::get_temp_op (Vector<CachedOp>& cache, int level, Real alpha, Real beta,
+                        MultiFab& Temperature, MultiFab& CrseTemp,
+                        Vector<std::unique_ptr<MultiFab> >& temp_cond_coef)
+{
+    BL_PROFILE("Diffusion::get_temp_op()");
+
     const BoxArray& ba = Temperature.boxArray();
     const DistributionMapping& dm = Temperature.DistributionMap();
 
-    LPInfo info;
-    info.setMetricTerm(true);
-    info.setMaxCoarseningLevel(0);
-    info.setAgglomeration(false);
-    info.setConsolidation(false);
+    auto& c = cache[level];
+
+    // The operator (with its metric terms and domain BCs) is built once
+    // per set of grids; after that only the BCs and coefficients change.
+
+    if (!c.op || c.ba != ba || c.dm != dm) {
+
+        if (verbose > 1) {
+            amrex::Print() << "... building the diffusion operator at level " << level << '\n';
+        }
+
+        c.mlmg.reset();
+
+        // Operators that are only applied don't need coarsening.
+
+        const bool apply_only = (&cache == &apply_ops);
+
+        LPInfo info;
+        info.setMetricTerm(true);
+        if (apply_only) {
+            info.setMaxCoarseningLevel(0);
+            info.setAgglomeration(false);
+            info.setConsolidation(false);
+        }
 
-    MLABecLaplacian mlabec({geom}, {ba}, {dm}, info);
-    mlabec.setMaxOrder(diffusion::mlmg_maxorder);
+        c.op = std::make_unique<MLABecLaplacian>(Vector<Geometry>{parent->Geom(level)},
+                                                 Vector<BoxArray>{ba},
+                                                 Vector<DistributionMapping>{dm}, info);
+        c.op->setMaxOrder(diffusion::mlmg_maxorder);
+        c.op->setDomainBC(mlmg_lobc, mlmg_hibc);
+        c.op->setScalars(alpha, beta);
 
-    mlabec.setDomainBC(mlmg_lobc, mlmg_hibc);
+        c.mlmg = std::make_unique<MLMG>(*c.op);
+        c.mlmg->setVerbose(verbose);
+
+        c.ba = ba;
+        c.dm = dm;
+    }
 
     if (level > 0) {
         const auto& rr = parent->refRatio(level-1);
-        mlabec.setCoarseFineBC(&CrseTemp, rr[0]);
+        c.op->setCoarseFineBC(&CrseTemp, rr[0]);
     }
-    mlabec.setLevelBC(0, &Temperature);
+    c.op->setLevelBC(0, &Temperature);
 
-    mlabec.setScalars(0.0, -1.0);
-    mlabec.setBCoeffs(0, Array<MultiFab const*, AMREX_SPACEDIM>{AMREX_D_DECL(temp_cond_coef[0].get(),
-                                                                             temp_cond_coef[1].get(),
-                                                                             temp_cond_coef[2].get())});
+    c.op->setBCoeffs(0, Array<MultiFab const*, AMREX_SPACEDIM>{AMREX_D_DECL(temp_cond_coef[0].get(),
+                                                                            temp_cond_coef[1].get(),
+                                                                            temp_cond_coef[2].get())});
 
-    MLMG mlmg(mlabec);
-    mlmg.setVerbose(verbose);
-    mlmg.apply({&DiffTerm}, {&Temperature});
+    return *c.mlmg;
+}
+
+void
+Diffusion::integrate_rkl2 (int level, MultiFab& Temperature,
+                           MultiFab& CrseTemp, const MultiFab& rho_cv,
+                           Vector<std::unique_ptr<MultiFab> >& temp_cond_coef,
+                           Real dt, MultiFab& DeltaT)
+{
+    BL_PROFILE("Diffusion::integrate_rkl2()");
+
+    const BoxArray& ba = Temperature.boxArray();
+    const DistributionMapping& dm = Temperature.DistributionMap();
+    const auto dxinv = parent->Geom(level).InvCellSizeArray();
+
+    // Bound the spectral radius of the operator (1 / rho c_v) div (k grad)
+    // by its largest row sum (Gershgorin); the forward Euler step is stable
+    // for dt <= 1 / (that row sum).  The operator includes the metric
+    // terms, so each face contributes A_face k_face / (dx V), which in
+    // r-z and spherical geometry is larger than the Cartesian k / dx^2
+    // near the origin.
+
+    auto const& rc = rho_cv.const_arrays();
+    auto const& vol = volume[level]->const_arrays();
+    AMREX_D_TERM(auto const& kx = temp_cond_coef[0]->const_arrays();,
+                 auto const& ky = temp_cond_coef[1]->const_arrays();,
+                 auto const& kz = temp_cond_coef[2]->const_arrays(););
+    AMREX_D_TERM(auto const& ax = area[level][0].const_arrays();,
+                 auto const& ay = area[level][1].const_arrays();,
+                 auto const& az = area[level][2].const_arrays(););
+
+    Real rowsum = amrex::ParReduce(TypeList<ReduceOpMax>{}, TypeList<Real>{}, rho_cv,
+    [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) -> GpuTuple<Real>
+    {
+        const Real rcv = rc[box_no](i,j,k);
+        if (rcv <= 0.0_rt) {
+            return {0.0_rt};
+        }
+
+        Real sum = AMREX_D_TERM((ax[box_no](i,j,k) * kx[box_no](i,j,k) + ax[box_no](i+1,j,k) * kx[box_no](i+1,j,k)) * dxinv[0],
+                               + (ay[box_no](i,j,k) * ky[box_no](i,j,k) + ay[box_no](i,j+1,k) * ky[box_no](i,j+1,k)) * dxinv[1],
+                               + (az[box_no](i,j,k) * kz[box_no](i,j,k) + az[box_no](i,j,k+1) * kz[box_no](i,j,k+1)) * dxinv[2]);
+
+        return {sum / (rcv * vol[box_no](i,j,k))};
+    });
+
+    ParallelDescriptor::ReduceRealMax(rowsum);
+
+    if (rowsum <= 0.0_rt) {
+        DeltaT.setVal(0.0_rt);
+        return;
+    }
+
+    // The bound is not sharp for the metric terms or for a varying k, and
+    // there is no margin at the RKL2 stability limit itself, so we keep
+    // the stages a safety factor inside it.
+
+    const Real dt_expl = diffusion::sts_safety_factor / rowsum;
+
+    // RKL2 with s stages is stable for dt <= dt_expl (s^2 + s - 2) / 4.  If
+    // that would take more than sts_max_stages stages, we take several
+    // super-steps.
+
+    auto stages_for = [=] (Real tau) -> int
+    {
+        const Real s = 0.5_rt * (std::sqrt(9.0_rt + 16.0_rt * tau / dt_expl) - 1.0_rt);
+        return amrex::max(2, static_cast<int>(std::ceil(s)));
+    };
+
+    int nsub = 1;
+    int s = stages_for(dt);
+    const int max_stages = amrex::max(2, diffusion::sts_max_stages);
+    while (s > max_stages) {
+        ++nsub;
+        s = stages_for(dt / nsub);
+    }
+
+    const Real tau = dt / nsub;
+
+    if (verbose > 0) {
+        amrex::Print() << "... RKL2 thermal diffusion at level " << level << ": dt / dt_explicit = "
+                       << dt / dt_expl << ", " << nsub << " super-step(s) of " << s << " stages" << std::endl;
+    }
+
+    MLMG& mlmg = get_temp_op(apply_ops, level, 0.0, -1.0, Temperature, CrseTemp, temp_cond_coef);
+
+    // Y0 holds the start of the current super-step; the stages rotate
+    // through the other three.
+
+    MultiFab Y0(ba, dm, 1, 1);
+    MultiFab Ya(ba, dm, 1, 1);
+    MultiFab Yb(ba, dm, 1, 1);
+    MultiFab Yc(ba, dm, 1, 1);
+    MultiFab LY0(ba, dm, 1, 0);
+    MultiFab LY(ba, dm, 1, 0);
+
+    MultiFab::Copy(Y0, Temperature, 0, 0, 1, 1);
+
+    // Apply (1 / rho c_v) div (k grad) to Y, giving LYout.
+
+    auto apply_op = [&] (MultiFab& Y, MultiFab& LYout)
+    {
+        mlmg.apply({&LYout}, {&Y});
+        MultiFab::Divide(LYout, rho_cv, 0, 0, 1, 0);
+    };
+
+    // Coefficients of Meyer, Balsara & Aslam (2014).
+
+    auto b = [] (int j) -> Real
+    {
+        return (j < 2) ? 1.0_rt / 3.0_rt
+                       : static_cast<Real>(j * j + j - 2) / static_cast<Real>(2 * j * (j + 1));
+    };
+
+    const Real w1 = 4.0_rt / static_cast<Real>(s * s + s - 2);
+
+    for (int isub = 0; isub < nsub; ++isub)
+    {
+        apply_op(Y0, LY0);
+
+        // Y1 = Y0 + mu~_1 tau L(Y0)
+
+        MultiFab* Yjm2 = &Y0;
+        MultiFab* Yjm1 = &Ya;
+        MultiFab* Yj   = &Yb;
+
+        MultiFab::Copy(*Yjm1, Y0, 0, 0, 1, 1);
+        MultiFab::Saxpy(*Yjm1, b(1) * w1 * tau, LY0, 0, 0, 1, 0);
+
+        for (int j = 2; j <= s; ++j)
+        {
+            apply_op(*Yjm1, LY);
+
+            const Real mu = static_cast<Real>(2 * j - 1) / static_cast<Real>(j) * b(j) / b(j-1);
+            const Real nu = -static_cast<Real>(j - 1) / static_cast<Real>(j) * b(j) / b(j-2);
+            const Real mut = mu * w1;
+            const Real gamt = -(1.0_rt - b(j-1)) * mut;
+
+            auto const& y0 = Y0.const_arrays();
+            auto const& yjm1 = Yjm1->const_arrays();
+            auto const& yjm2 = Yjm2->const_arrays();
+            auto const& ly0 = LY0.const_arrays();
+            auto const& ly = LY.const_arrays();
+            auto const& yj = Yj->arrays();
+
+            amrex::ParallelFor(*Yj,
+            [=] AMREX_GPU_DEVICE (int box_no, int i, int jj, int k) noexcept
+            {
+                yj[box_no](i,jj,k) = mu * yjm1[box_no](i,jj,k) + nu * yjm2[box_no](i,jj,k)
+                                   + (1.0_rt - mu - nu) * y0[box_no](i,jj,k)
+                                   + mut * tau * ly[box_no](i,jj,k)
+                                   + gamt * tau * ly0[box_no](i,jj,k);
+            });
+
+            MultiFab* free_stage = (Yjm2 == &Y0) ? &Yc : Yjm2;
+            Yjm2 = Yjm1;
+            Yjm1 = Yj;
+            Yj = free_stage;
+        }
+
+        MultiFab::Copy(Y0, *Yjm1, 0, 0, 1, 0);
+    }
+
+    MultiFab::LinComb(DeltaT, 1.0_rt, Y0, 0, -1.0_rt, Temperature, 0, 0, 1, 0);
+}
+
+void
+Diffusion::solve_backward_euler (int level, MultiFab& Temperature,
+                                 MultiFab& CrseTemp, const MultiFab& rho_cv,
+                                 Vector<std::unique_ptr<MultiFab> >& temp_cond_coef,
+                                 Real dt, MultiFab& DeltaT)
+{
+    BL_PROFILE("Diffusion::solve_backward_euler()");
+
+    const BoxArray& ba = Temperature.boxArray();
+    const DistributionMapping& dm = Temperature.DistributionMap();
+
+    // (rho c_v / dt) T^{n+1} - div (k grad T^{n+1}) = (rho c_v / dt) T^n
+
+    MultiFab acoef(ba, dm, 1, 0);
+    MultiFab::Copy(acoef, rho_cv, 0, 0, 1, 0);
+    acoef.mult(1.0_rt / dt);
+
+    MultiFab rhs(ba, dm, 1, 0);
+    MultiFab::Copy(rhs, acoef, 0, 0, 1, 0);
+    MultiFab::Multiply(rhs, Temperature, 0, 0, 1, 0);
+
+    MLMG& mlmg = get_temp_op(implicit_ops, level, 1.0, 1.0, Temperature, CrseTemp, temp_cond_coef);
+    implicit_ops[level].op->setACoeffs(0, acoef);
+
+    MultiFab Tnew(ba, dm, 1, 1);
+    MultiFab::Copy(Tnew, Temperature, 0, 0, 1, 1);
+
+    mlmg.solve({&Tnew}, {&rhs}, diffusion::implicit_rel_tol, diffusion::implicit_abs_tol);
+
+    MultiFab::LinComb(DeltaT, 1.0_rt, Tnew, 0, -1.0_rt, Temperature, 0, 0, 1, 0);
 }
@@ -11,6 +11,7 @@
 #include <string>
 #include <ctime>
 #include <memory>
+#include <map>
 
 #include <AMReX_Utility.H>
 #include <AMReX_CONSTANTS.H>
@@ -86,6 +87,7 @@ Vector<AMRErrorTag> Castro::error_tags;
 
 Vector<std::unique_ptr<std::fstream>> Castro::data_logs;
 Vector<std::unique_ptr<std::fstream>> Castro::problem_data_logs;
+Vector<std::unique_ptr<BinaryDiagLog>> Castro::binary_data_logs;
 
 #ifdef TRUE_SDC
 int          Castro::SDC_NODES;
@@ -137,6 +139,12 @@ IntVect      Castro::no_tile_size(1024,1024,1024);
 int          Castro::hydro_tile_size_has_been_tuned = 0;
 Long         Castro::largest_box_from_hydro_tile_size_tuning = 0;
 
+// the candidate tile sizes (and their measured cost per zone) when
+// tuning the hydro tile size on CPUs
+Vector<IntVect> Castro::hydro_tile_size_candidates;
+Vector<Real> Castro::hydro_tile_size_candidate_times;
+int          Castro::hydro_tile_size_candidate_index = -1;
+
 // this will be reset upon restart
 Real         Castro::previousCPUTimeUsed = 0.0;
 
@@ -153,6 +161,9 @@ int          Castro::do_cxx_prob_initialize = 0;
 void
 Castro::variableCleanUp ()
 {
+  // Make sure that the last checkpoint is complete.
+  finish_async_checkpoint();
+
 #ifdef GRAVITY
   if (gravity != nullptr) {
     if (verbose > 1 && ParallelDescriptor::IOProcessor()) {
@@ -188,17 +199,36 @@ Castro::variableCleanUp ()
 #endif
 
 #ifdef AMREX_PARTICLES
+  // Write out anything still buffered in the particle history.
+  if (particle_history) {
+      particle_history->flush();
+      particle_history.reset();
+  }
+
   delete TracerPC;
   TracerPC = 0;
 #endif
 
     desc_lst.clear();
 
+    // Destroying the binary logs writes out anything still buffered.
+    binary_data_logs.clear();
+
     // C++ cleaning
     eos_finalize();
 
 }
 
+void
+Castro::flush_binary_data_logs ()
+{
+    for (auto& log : binary_data_logs) {
+        if (log) {
+            log->flush();
+        }
+    }
+}
+
 void
 Castro::read_params ()
 {
@@ -430,6 +460,16 @@ Castro::read_params ()
         amrex::Error();
     }
 
+#ifdef DIFFUSION
+    if (diffusion::temporal_method < 0 || diffusion::temporal_method > 2) {
+        amrex::Error("diffusion.temporal_method must be 0, 1, or 2");
+    }
+
+    if (diffusion::temporal_method != 0 && time_integration_method != CornerTransportUpwind) {
+        amrex::Error("diffusion.temporal_method != 0 is only supported with the CTU time integration");
+    }
+#endif
+
     // This interpolation is not currently implemented for some geometries
     if (lin_limit_state_interp == 2) {
         if (dgeom.IsSPHERICAL()) {
@@ -519,9 +559,13 @@ Castro::read_params ()
    // we should use consistent indexing regardless of ifdefs (so some
    // logs may be unused in a given run).
 
-   if (sum_interval > 0 && ParallelDescriptor::IOProcessor()) {
+   // The binary logs (castro.diag_log_format = 1 or 2) are written in
+   // addition to, or instead of, the ASCII ones.
+
+   data_logs.resize(4);
+   binary_data_logs.resize(4);
 
-       data_logs.resize(4);
+   if (sum_interval > 0 && ParallelDescriptor::IOProcessor() && diag_log_format != 1) {
 
        data_logs[0] = std::make_unique<std::fstream>();
        data_logs[0]->open("grid_diag.out", std::ios::out | std::ios::app);
@@ -549,6 +593,17 @@ Castro::read_params ()
            amrex::FileOpenFailed("amr_diag.out");
        }
 
+   }
+
+   if (sum_interval > 0 && ParallelDescriptor::IOProcessor() && diag_log_format >= 1) {
+
+       binary_data_logs[0] = std::make_unique<BinaryDiagLog>("grid_diag.bin");
+#ifdef GRAVITY
+       binary_data_logs[1] = std::make_unique<BinaryDiagLog>("gravity_diag.bin");
+#endif
+       binary_data_logs[2] = std::make_unique<BinaryDiagLog>("species_diag.bin");
+       binary_data_logs[3] = std::make_unique<BinaryDiagLog>("amr_diag.bin");
+
    }
 
     Vector<int> tilesize(AMREX_SPACEDIM);
@@ -889,7 +944,10 @@ Castro::initMFs()
 
 
 #ifdef REACTIONS
-    if (store_burn_weights) {
+    // the burn weights are also used as the cost estimate for load balancing,
+    // and for sorting the zones in the batched burner
+
+    if (store_burn_weights || load_balance_int > 0 || react_batched == 1) {
 #ifdef STRANG
         // we have 2 components: first half and second half
         burn_weights.define(grids, dmap, 2, 0);
@@ -948,8 +1006,20 @@ Castro::initMFs()
       // sure it's done after the above call to init_prob_parameters() in case
       // any changes are made to the problem parameters.
 
+      const Real strt_time = ParallelDescriptor::second();
+
       problem_initialize();
 
+      if (verbose > 0) {
+          const int IOProc = ParallelDescriptor::IOProcessorNumber();
+          Real run_time = ParallelDescriptor::second() - strt_time;
+
+          ParallelDescriptor::ReduceRealMax(run_time, IOProc);
+          if (ParallelDescriptor::IOProcessor()) {
+              std::cout << "Castro: problem_initialize() time = " << run_time << std::endl;
+          }
+      }
+
     }
 
 }
@@ -968,6 +1038,28 @@ Castro::initData ()
 {
     BL_PROFILE("Castro::initData()");
 
+    // With verbose > 0, we report how long each phase of the
+    // initialization takes (synchronizing the GPU at the end of each).
+
+    auto timer = [&] () -> Real {
+        if (verbose > 0) {
+            Gpu::streamSynchronize();
+        }
+        return ParallelDescriptor::second();
+    };
+
+    const Real strt_time = timer();
+    Real last_time = strt_time;
+
+    // problem init, temperature, checks, energy, FillPatch
+    Real phase_time[5] = {0.0};
+
+    auto lap = [&] (int phase) {
+        Real t = timer();
+        phase_time[phase] += t - last_time;
+        last_time = t;
+    };
+
     //
     // Loop over grids, call FORTRAN function to init with data.
     //
@@ -1041,6 +1133,7 @@ Castro::initData ()
 
 #ifdef MAESTRO_INIT
     MAESTRO_init();
+    amrex::ignore_unused(lap);
 #else
     {
 
@@ -1124,6 +1217,8 @@ Castro::initData ()
 #endif
        }
 
+       lap(0);
+
 
 #ifdef MHD
       //correct energy density with the magnetic field contribution 
@@ -1143,6 +1238,8 @@ Castro::initData ()
 #endif
                    S_new, cur_time, 0);
 
+       lap(1);
+
        ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
        ReduceData<int, int> reduce_data(reduce_op);
        using ReduceTuple = typename decltype(reduce_data)::Type;
@@ -1227,6 +1324,8 @@ Castro::initData ()
          });
        }
 
+       lap(2);
+
 #ifdef TRUE_SDC
        if (initialization_is_cell_average == 0) {
          // we are assuming that the initialization was done to cell-centers
@@ -1351,6 +1450,8 @@ Castro::initData ()
                             S_new);
 #endif
 
+       lap(3);
+
        // Do a FillPatch so that we can get the ghost zones filled.
 
        int ng = S_new.nGrow();
@@ -1358,6 +1459,8 @@ Castro::initData ()
        if (ng > 0) {
          AmrLevel::FillPatch(*this, S_new, ng, cur_time, State_Type, 0, S_new.nComp());
        }
+
+       lap(4);
     }
 
     clean_state(
@@ -1425,6 +1528,24 @@ Castro::initData ()
 
     Gpu::Device::profilerStart();
 
+    if (verbose > 0) {
+        const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+        Real run_time[6] = {phase_time[0], phase_time[1], phase_time[2],
+                            phase_time[3], phase_time[4], timer() - strt_time};
+
+        ParallelDescriptor::ReduceRealMax(run_time, 6, IOProc);
+        if (ParallelDescriptor::IOProcessor()) {
+            std::cout << "Castro::initData() at level " << level
+                      << " : problem init time = " << run_time[0]
+                      << ", temperature time = " << run_time[1]
+                      << ", checks time = " << run_time[2]
+                      << ", energy time = " << run_time[3]
+                      << ", fill patch time = " << run_time[4]
+                      << ", total time = " << run_time[5] << std::endl;
+        }
+    }
+
     if (verbose && ParallelDescriptor::IOProcessor()) {
       std::cout << "Done initializing the level " << level << " data " << std::endl;
     }
@@ -1475,6 +1596,15 @@ Castro::init (AmrLevel &old)
 
     in_retry = oldlev->in_retry;
 
+#ifdef REACTIONS
+    // Keep the measured burn cost so that it can be used for
+    // load balancing on the new grids.
+
+    if (burn_weights.isDefined() && oldlev->burn_weights.isDefined()) {
+        burn_weights.ParallelCopy(oldlev->burn_weights, 0, 0, burn_weights.nComp());
+    }
+#endif
+
 }
 
 //
@@ -1606,7 +1736,10 @@ Castro::estTimeStep (int is_new)
 
     Real estdt_diffusion = max_dt / cfl;
 
-    if (diffuse_temp)
+    // Super-time-stepping and the implicit update are not limited by
+    // the explicit diffusion timestep.
+
+    if (diffuse_temp && diffusion::temporal_method == 0)
     {
         auto diffuse_dt = estdt_temp_diffusion(is_new);
         ParallelAllReduce::Min(diffuse_dt, MPI_COMM_WORLD);
@@ -1993,6 +2126,8 @@ Castro::post_timestep (int iteration_local)
     // responsible for any actions after this point, like
     // doing a computeTemp call if they change the state data.
 
+    invalidate_eos_cache();
+
     problem_post_timestep();
 
 #endif
@@ -2056,9 +2191,46 @@ Castro::post_timestep (int iteration_local)
         {
             int ngrow = (level == 0) ? 0 : iteration_local;
 
+            Real strt_time = ParallelDescriptor::second();
+
             TracerPC->Redistribute(level, parent->finestLevel(), ngrow);
 
+            Real redist_time = ParallelDescriptor::second();
+
+            // Periodically put the particles in each tile in cell (Morton)
+            // order, so the interpolation kernels walk memory coherently.
+
+            if (level == 0 && particles::sort_interval > 0 &&
+                parent->levelSteps(0) % particles::sort_interval == 0) {
+                sort_tracer_particles();
+            }
+
+            Real sort_time = ParallelDescriptor::second();
+
             TimestampParticles(ngrow+1);
+
+            if (verbose)
+            {
+                const int IOProc = ParallelDescriptor::IOProcessorNumber();
+                Real end_time = ParallelDescriptor::second();
+                Real run_time[3] = {redist_time - strt_time,
+                                    sort_time - redist_time,
+                                    end_time - sort_time};
+
+#ifdef BL_LAZY
+                Lazy::QueueReduction( [=] () mutable {
+#endif
+                ParallelDescriptor::ReduceRealMax(run_time, 3, IOProc);
+                if (ParallelDescriptor::IOProcessor()) {
+                    std::cout << "Castro particles at level " << level
+                              << " : redistribute time = " << run_time[0]
+                              << ", sort time = " << run_time[1]
+                              << ", timestamp time = " << run_time[2] << std::endl;
+                }
+#ifdef BL_LAZY
+                });
+#endif
+            }
         }
     }
 #endif
@@ -2626,6 +2798,10 @@ Castro::reflux (int crse_level, int fine_level, bool in_post_timestep)
 
     const Real strt = ParallelDescriptor::second();
 
+    for (int lev = crse_level; lev <= fine_level; ++lev) {
+        getLevel(lev).invalidate_eos_cache();
+    }
+
 #ifdef GRAVITY
     int nlevs = fine_level - crse_level + 1;
 
@@ -3251,6 +3427,14 @@ Castro::check_for_negative_density ()
     ReduceData<int, int> reduce_data(reduce_op);
     using ReduceTuple = typename decltype(reduce_data)::Type;
 
+    // Keep track of which boxes failed, in case we do a local retry.
+
+    const int pass = retry_local_pass;
+    const bool record_failed_boxes = retry_local == 1 && pass == 0;
+
+    Gpu::DeviceVector<int> box_failed(record_failed_boxes ? S_new.size() : 0, 0);
+    int* p_box_failed = box_failed.data();
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
@@ -3260,12 +3444,21 @@ Castro::check_for_negative_density ()
         auto S_old_arr = S_old.array(mfi);
         auto S_new_arr = S_new.array(mfi);
 
+        const int box_index = mfi.index();
+        const auto retry_mask = pass > 0 ? retry_local_mask.array(mfi) : Array4<int>{};
+
         reduce_op.eval(bx, reduce_data,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
         {
             int rho_check_failed = 0;
             int X_check_failed = 0;
 
+            // Zones that will be replaced in a local retry don't need to be valid.
+
+            if (pass > 0 && retry_local_skip(pass, retry_mask(i,j,k))) {
+                return {0, 0};
+            }
+
             Real rho = S_new_arr(i,j,k,URHO);
             Real rhoInv = 1.0_rt / rho;
 
@@ -3299,6 +3492,10 @@ Castro::check_for_negative_density ()
 
             }
 
+            if (p_box_failed && (rho_check_failed || X_check_failed)) {
+                Gpu::Atomic::Add(p_box_failed + box_index, 1);
+            }
+
             return {rho_check_failed, X_check_failed};
         });
 
@@ -3308,6 +3505,10 @@ Castro::check_for_negative_density ()
     int rho_check_failed = amrex::get<0>(hv);
     int X_check_failed = amrex::get<1>(hv);
 
+    if (record_failed_boxes && (rho_check_failed || X_check_failed)) {
+        record_retry_failed_boxes(box_failed);
+    }
+
     ParallelDescriptor::ReduceIntMax(rho_check_failed);
     ParallelDescriptor::ReduceIntMax(X_check_failed);
 
@@ -3390,6 +3591,10 @@ Castro::avgDown (int state_indx)
     MultiFab&  S_crse   = get_new_data(state_indx);
     MultiFab&  S_fine   = fine_lev.get_new_data(state_indx);
 
+    if (state_indx == State_Type) {
+        invalidate_eos_cache();
+    }
+
     amrex::average_down(S_fine, S_crse,
                          fgeom, cgeom,
                          0, S_fine.nComp(), fine_ratio);
@@ -3433,70 +3638,100 @@ Castro::errorEst (TagBoxArray& tags,
       ltime = get_state_data(State_Type).curTime();
     }
 
-    // Apply each of the tagging criteria defined in the inputs.
+    // Apply each of the tagging criteria defined in the inputs. Several
+    // criteria often use the same field, so each field is derived only
+    // once, with enough ghost cells for all of the criteria that use it,
+    // and it is freed after the last criterion that needs it.
+
+    std::map<std::string, int> field_ngrow;
+    std::map<std::string, int> field_last_use;
 
-    for (const auto & etag : error_tags) {
-        std::unique_ptr<MultiFab> mf;
-        if (! etag.Field().empty()) {
-            mf = derive(etag.Field(), time, etag.NGrow());
+    for (int n = 0; n < error_tags.size(); ++n) {
+        const std::string& field = error_tags[n].Field();
+        if (field.empty()) {
+            continue;
         }
-        etag(tags, mf.get(), TagBox::CLEAR, TagBox::SET, time, level, geom);
+        auto it = field_ngrow.find(field);
+        if (it == field_ngrow.end()) {
+            field_ngrow[field] = error_tags[n].NGrow();
+        } else {
+            it->second = amrex::max(it->second, error_tags[n].NGrow());
+        }
+        field_last_use[field] = n;
     }
 
-    // Now we'll tag any user-specified zones using the full state array.
+    std::map<std::string, std::unique_ptr<MultiFab>> fields;
 
-    apply_problem_tags(tags, ltime);
+    for (int n = 0; n < error_tags.size(); ++n) {
+        const auto& etag = error_tags[n];
+        const std::string& field = etag.Field();
 
-    // Finally we'll apply any tagging restrictions which must be obeyed by any setup.
+        MultiFab* mf = nullptr;
+        if (! field.empty()) {
+            auto& field_mf = fields[field];
+            if (field_mf == nullptr) {
+                field_mf = derive_tag_field(field, time, field_ngrow[field]);
+            }
+            mf = field_mf.get();
+        }
 
-    apply_tagging_restrictions(tags, ltime);
+        etag(tags, mf, TagBox::CLEAR, TagBox::SET, time, level, geom);
 
-}
+        if (! field.empty() && field_last_use[field] == n) {
+            fields.erase(field);
+        }
+    }
 
+    // Now we'll tag any user-specified zones using the full state array,
+    // and then apply any tagging restrictions which must be obeyed by any
+    // setup. These are done together in a single pass.
 
+    apply_problem_tags(tags, ltime);
 
-void
-Castro::apply_problem_tags (TagBoxArray& tags, Real time)
-{
+}
 
-    amrex::ignore_unused(time);
 
-    BL_PROFILE("Castro::apply_problem_tags()");
 
-    MultiFab& S_new = get_new_data(State_Type);
+std::unique_ptr<MultiFab>
+Castro::derive_tag_field (const std::string& name, Real time, int ngrow)
+{
+    // A state variable that is needed without ghost cells at the new
+    // time is exactly the new-time state data, so we can use that in
+    // place rather than copying it with a FillPatch.
 
-    int lev = level;
+    int state_indx = -1;
+    int comp = -1;
 
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-    {
-        for (MFIter mfi(tags, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-        {
-            const Box& bx = mfi.tilebox();
+    if (ngrow == 0 && isStateVariable(name, state_indx, comp) && state_indx == State_Type) {
 
-            TagBox& tagfab = tags[mfi];
+        const StateData& state_data = get_state_data(State_Type);
 
-            auto tag_arr = tagfab.array();
-            const auto state_arr = S_new[mfi].array();
-            const GeometryData& geomdata = geom.data();
+        const Real teps = (state_data.curTime() - state_data.prevTime()) * 1.e-3_rt;
 
-            amrex::ParallelFor(bx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                problem_tagging(i, j, k, tag_arr, state_arr, lev, geomdata);
-            });
+        if (std::abs(time - state_data.curTime()) <= teps) {
+            return std::make_unique<MultiFab>(get_new_data(State_Type), amrex::make_alias, comp, 1);
         }
+
     }
 
+    return derive(name, time, ngrow);
 }
 
 
 
 void
-Castro::apply_tagging_restrictions(TagBoxArray& tags, [[maybe_unused]] Real time)
+Castro::apply_problem_tags (TagBoxArray& tags, Real time)
 {
-    BL_PROFILE("Castro::apply_tagging_restrictions()");
+
+    amrex::ignore_unused(time);
+
+    BL_PROFILE("Castro::apply_problem_tags()");
+
+    MultiFab& S_new = get_new_data(State_Type);
+
+    int lev = level;
+
+    const GeometryData geomdata = geom.data();
 
     // If we are using Poisson gravity, we must ensure that the outermost zones are untagged
     // due to the Poisson equation boundary conditions (we currently do not know how to fill
@@ -3510,18 +3745,21 @@ Castro::apply_tagging_restrictions(TagBoxArray& tags, [[maybe_unused]] Real time
     // need to stay a further amount n_error_buf away, since n_error_buf zones are always
     // added as padding around tagged zones.
 
+    bool untag_outer_boundary = false;
+
+    GpuArray<int, 3> n_error_buf = {0};
+    GpuArray<int, 3> ref_ratio = {0};
+    GpuArray<int, 3> domlo = {0};
+    GpuArray<int, 3> domhi = {0};
+    GpuArray<int, 3> physbc_lo = {-1};
+    GpuArray<int, 3> physbc_hi = {-1};
+    GpuArray<int, 3> blocking_factor = {0};
+
 #ifdef GRAVITY
     if (gravity::gravity_type == "PoissonGrav") {
 
-        int lev = level;
+        untag_outer_boundary = true;
 
-        int n_error_buf[3] = {0};
-        int ref_ratio[3] = {0};
-        int domlo[3] = {0};
-        int domhi[3] = {0};
-        int physbc_lo[3] = {-1};
-        int physbc_hi[3] = {-1};
-        int blocking_factor[3] = {0};
         for (int dim = 0; dim < AMREX_SPACEDIM; ++dim) {
             n_error_buf[dim] = parent->nErrorBuf(lev, dim);
             ref_ratio[dim] = parent->refRatio(lev)[dim];
@@ -3532,96 +3770,106 @@ Castro::apply_tagging_restrictions(TagBoxArray& tags, [[maybe_unused]] Real time
             blocking_factor[dim] = parent->blockingFactor(lev)[dim];
         }
 
+    }
+#endif
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
-        for (MFIter mfi(tags, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    {
+        for (MFIter mfi(tags, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
             const Box& bx = mfi.tilebox();
 
-            auto tag = tags[mfi].array();
+            TagBox& tagfab = tags[mfi];
+
+            auto tag_arr = tagfab.array();
+            const auto state_arr = S_new[mfi].array();
 
             amrex::ParallelFor(bx,
             [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
             {
-                bool outer_boundary_test[3] = {false};
+                problem_tagging(i, j, k, tag_arr, state_arr, lev, geomdata);
 
-                int idx[3] = {i, j, k};
+                // Tagging restrictions, which override the problem tags.
 
-                for (int dim = 0; dim < AMREX_SPACEDIM; ++dim) {
+                if (untag_outer_boundary) {
 
-                    int boundary_buf = n_error_buf[dim] + blocking_factor[dim] / ref_ratio[dim];
+                    bool outer_boundary_test[3] = {false};
 
-                    if ((physbc_lo[dim] != amrex::PhysBCType::symmetry && physbc_lo[dim] != amrex::PhysBCType::interior) &&
-                        (idx[dim] <= domlo[dim] + boundary_buf)) {
-                        outer_boundary_test[dim] = true;
-                    }
+                    int idx[3] = {i, j, k};
 
-                    if ((physbc_hi[dim] != amrex::PhysBCType::symmetry && physbc_lo[dim] != amrex::PhysBCType::interior) &&
-                        (idx[dim] >= domhi[dim] - boundary_buf)) {
-                        outer_boundary_test[dim] = true;
-                    }
-                }
+                    for (int dim = 0; dim < AMREX_SPACEDIM; ++dim) {
 
-                if (outer_boundary_test[0] || outer_boundary_test[1] || outer_boundary_test[2]) {
+                        int boundary_buf = n_error_buf[dim] + blocking_factor[dim] / ref_ratio[dim];
 
-                    tag(i,j,k) = TagBox::CLEAR;
+                        if ((physbc_lo[dim] != amrex::PhysBCType::symmetry && physbc_lo[dim] != amrex::PhysBCType::interior) &&
+                            (idx[dim] <= domlo[dim] + boundary_buf)) {
+                            outer_boundary_test[dim] = true;
+                        }
 
-                }
-            });
-        }
+                        if ((physbc_hi[dim] != amrex::PhysBCType::symmetry && physbc_lo[dim] != amrex::PhysBCType::interior) &&
+                            (idx[dim] >= domhi[dim] - boundary_buf)) {
+                            outer_boundary_test[dim] = true;
+                        }
+                    }
 
-    }
-#endif
+                    if (outer_boundary_test[0] || outer_boundary_test[1] || outer_boundary_test[2]) {
 
-    auto geomdata = geom.data();
+                        tag_arr(i,j,k) = TagBox::CLEAR;
 
-    // Allow the user to limit tagging outside of some distance from the problem center.
-#ifdef AMREX_USE_OMP
-#pragma omp parallel
-#endif
-    for (MFIter mfi(tags, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-        const Box& bx = mfi.tilebox();
+                    }
 
-        auto tag = tags[mfi].array();
+                }
 
-        amrex::ParallelFor(bx,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-        {
-            const Real* problo = geomdata.ProbLo();
-            const Real* probhi = geomdata.ProbHi();
-            const Real* dx = geomdata.CellSize();
+                // Allow the user to limit tagging outside of some distance from the problem center.
+
+                const Real* problo = geomdata.ProbLo();
+                const Real* probhi = geomdata.ProbHi();
+                const Real* dx = geomdata.CellSize();
 
-            Real loc[3] = {0.0};
+                Real loc[3] = {0.0};
 
-            loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
+                loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
 #if AMREX_SPACEDIM >= 2
-            loc[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1];
+                loc[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1];
 #endif
 #if AMREX_SPACEDIM == 3
-            loc[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2];
+                loc[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2];
 #endif
 
-            Real r = std::sqrt((loc[0] - problem::center[0]) * (loc[0] - problem::center[0]) +
-                               (loc[1] - problem::center[1]) * (loc[1] - problem::center[1]) +
-                               (loc[2] - problem::center[2]) * (loc[2] - problem::center[2]));
+                Real r = std::sqrt((loc[0] - problem::center[0]) * (loc[0] - problem::center[0]) +
+                                   (loc[1] - problem::center[1]) * (loc[1] - problem::center[1]) +
+                                   (loc[2] - problem::center[2]) * (loc[2] - problem::center[2]));
 
-            Real max_dist_lo = 0.0;
-            Real max_dist_hi = 0.0;
+                Real max_dist_lo = 0.0;
+                Real max_dist_hi = 0.0;
 
-            for (int dim = 0; dim < AMREX_SPACEDIM; ++dim) {
-                max_dist_lo = amrex::max(max_dist_lo, std::abs(problo[dim] - problem::center[dim]));
-                max_dist_hi = amrex::max(max_dist_hi, std::abs(probhi[dim] - problem::center[dim]));
-            }
+                for (int dim = 0; dim < AMREX_SPACEDIM; ++dim) {
+                    max_dist_lo = amrex::max(max_dist_lo, std::abs(problo[dim] - problem::center[dim]));
+                    max_dist_hi = amrex::max(max_dist_hi, std::abs(probhi[dim] - problem::center[dim]));
+                }
 
-            if (r > castro::max_tagging_radius * amrex::max(max_dist_lo, max_dist_hi)) {
-                tag(i,j,k) = TagBox::CLEAR;
-            }
-        });
+                if (r > castro::max_tagging_radius * amrex::max(max_dist_lo, max_dist_hi)) {
+                    tag_arr(i,j,k) = TagBox::CLEAR;
+                }
+            });
+        }
     }
+
 }
 
 
 
+// The derived variables that can be filled directly from the EOS cache.
+
+static bool
+derived_from_eos_cache (const std::string& name)
+{
+    return name == "pressure" || name == "soundspeed" ||
+           name == "Gamma_1" || name == "MachNumber";
+}
+
 std::unique_ptr<MultiFab>
 Castro::derive (const std::string& name,
                 Real           time,
@@ -3630,6 +3878,13 @@ Castro::derive (const std::string& name,
 
     BL_PROFILE("Castro::derive()");
 
+    if (ngrow == 0 && derived_from_eos_cache(name) && eos_cache_is_current(time)) {
+        auto mf = std::make_unique<MultiFab>(grids, dmap, 1, 0);
+        if (derive_from_eos_cache(name, time, *mf, 0)) {
+            return mf;
+        }
+    }
+
 #ifdef AMREX_PARTICLES
   return ParticleDerive(name,time,ngrow);
 #else
@@ -3646,9 +3901,80 @@ Castro::derive (const std::string& name,
 
     BL_PROFILE("Castro::derive()");
 
+    if (mf.nGrow() == 0 && derive_from_eos_cache(name, time, mf, dcomp)) {
+        return;
+    }
+
     AmrLevel::derive(name,time,mf,dcomp);
 }
 
+bool
+Castro::eos_cache_is_current (Real time) const
+{
+    if (castro::eos_cache == 0 || !eos_cache_valid) {
+        return false;
+    }
+
+    // The cache was filled from the new-time state, so it is only
+    // usable if that is still the data at the requested time.
+
+    const Real t_new = state[State_Type].curTime();
+
+    return eos_cache_time == t_new && time == t_new;
+}
+
+bool
+Castro::derive_from_eos_cache (const std::string& name, Real time,
+                               MultiFab& mf, int dcomp)
+{
+    if (!eos_cache_is_current(time)) {
+        return false;
+    }
+
+    if (!derived_from_eos_cache(name)) {
+        return false;
+    }
+
+    if (mf.boxArray() != eos_cache.boxArray() ||
+        mf.DistributionMap() != eos_cache.DistributionMap()) {
+        return false;
+    }
+
+    BL_PROFILE("Castro::derive_from_eos_cache()");
+
+    if (name == "pressure") {
+        MultiFab::Copy(mf, eos_cache, ECACHE_P, dcomp, 1, 0);
+    }
+    else if (name == "soundspeed") {
+        MultiFab::Copy(mf, eos_cache, ECACHE_CS, dcomp, 1, 0);
+    }
+    else if (name == "Gamma_1") {
+        MultiFab::Copy(mf, eos_cache, ECACHE_GAMC, dcomp, 1, 0);
+    }
+    else {
+        const MultiFab& S_new = get_new_data(State_Type);
+
+        auto const& ua = S_new.const_arrays();
+        auto const& ca = eos_cache.const_arrays();
+        auto const& ma = mf.arrays();
+
+        amrex::ParallelFor(mf,
+        [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) noexcept
+        {
+            Array4<Real const> const& u = ua[box_no];
+
+            ma[box_no](i,j,k,dcomp) = std::sqrt(u(i,j,k,UMX) * u(i,j,k,UMX) +
+                                                u(i,j,k,UMY) * u(i,j,k,UMY) +
+                                                u(i,j,k,UMZ) * u(i,j,k,UMZ)) /
+                u(i,j,k,URHO) / ca[box_no](i,j,k,ECACHE_CS);
+        });
+
+        Gpu::streamSynchronize();
+    }
+
+    return true;
+}
+
 void
 Castro::extern_init ()
 {
@@ -3970,6 +4296,25 @@ Castro::computeTemp(
   }
 #endif
 
+  // If we are operating on the new-time state, we can cache the EOS
+  // results for use by estdt_cfl and the derived variables later.
+  // For the fourth-order methods we operate on cell centers, which
+  // are not what the consumers of the cache want, so we skip it.
+
+  bool fill_eos_cache = castro::eos_cache == 1 && &State == &get_new_data(State_Type);
+#ifdef TRUE_SDC
+  if (sdc_order == 4) {
+      fill_eos_cache = false;
+  }
+#endif
+
+  eos_cache_valid = false;
+
+  if (fill_eos_cache && (eos_cache.boxArray() != State.boxArray() ||
+                         eos_cache.DistributionMap() != State.DistributionMap())) {
+      eos_cache.define(State.boxArray(), State.DistributionMap(), ECACHE_NCOMP, 0);
+  }
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
@@ -3993,31 +4338,76 @@ Castro::computeTemp(
 
       Array4<Real> const u = u_fab.array();
 
-      amrex::ParallelFor(bx,
-      [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-      {
+      if (fill_eos_cache) {
 
-          Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+          // This is the same update as below, but we ask the EOS for
+          // the pressure and its derivatives too and store them for
+          // the zones in the valid region.
 
-          eos_re_t eos_state;
+          const Box& vbx = mfi.tilebox();
+          auto const cache = eos_cache.array(mfi);
 
-          eos_state.rho = u(i,j,k,URHO);
-          eos_state.T   = u(i,j,k,UTEMP); // Initial guess for the EOS
-          eos_state.e   = u(i,j,k,UEINT) * rhoInv;
-          for (int n = 0; n < NumSpec; ++n) {
-            eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
-          }
+          amrex::ParallelFor(bx,
+          [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+          {
+              Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+
+              eos_rep_t eos_state;
+
+              eos_state.rho = u(i,j,k,URHO);
+              eos_state.T   = u(i,j,k,UTEMP); // Initial guess for the EOS
+              eos_state.e   = u(i,j,k,UEINT) * rhoInv;
+              for (int n = 0; n < NumSpec; ++n) {
+                eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+              }
 #if NAUX_NET > 0
-          for (int n = 0; n < NumAux; ++n) {
-            eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
-          }
+              for (int n = 0; n < NumAux; ++n) {
+                eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+              }
 #endif
 
-          eos(eos_input_re, eos_state);
+              eos(eos_input_re, eos_state);
 
-          u(i,j,k,UTEMP) = eos_state.T;
+              u(i,j,k,UTEMP) = eos_state.T;
 
-      });
+              if (vbx.contains(IntVect(AMREX_D_DECL(i,j,k)))) {
+                  cache(i,j,k,ECACHE_P) = eos_state.p;
+                  cache(i,j,k,ECACHE_CS) = eos_state.cs;
+                  cache(i,j,k,ECACHE_GAMC) = eos_state.gam1;
+                  cache(i,j,k,ECACHE_DPDR) = eos_state.dpdr_e;
+                  cache(i,j,k,ECACHE_DPDE) = eos_state.dpde;
+              }
+          });
+
+      } else {
+
+          amrex::ParallelFor(bx,
+          [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+          {
+
+              Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+
+              eos_re_t eos_state;
+
+              eos_state.rho = u(i,j,k,URHO);
+              eos_state.T   = u(i,j,k,UTEMP); // Initial guess for the EOS
+              eos_state.e   = u(i,j,k,UEINT) * rhoInv;
+              for (int n = 0; n < NumSpec; ++n) {
+                eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+              }
+#if NAUX_NET > 0
+              for (int n = 0; n < NumAux; ++n) {
+                eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+              }
+#endif
+
+              eos(eos_input_re, eos_state);
+
+              u(i,j,k,UTEMP) = eos_state.T;
+
+          });
+
+      }
 
       if (clamp_ambient_temp == 1) {
           amrex::ParallelFor(bx,
@@ -4033,9 +4423,52 @@ Castro::computeTemp(
                                                                        u(i,j,k,UMZ) * u(i,j,k,UMZ));
               }
           });
+
+          if (fill_eos_cache) {
+
+              // The clamped zones have a new thermodynamic state, so
+              // we need to redo the EOS call there for the cache.
+
+              auto const cache = eos_cache.array(mfi);
+
+              amrex::ParallelFor(mfi.tilebox(),
+              [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+              {
+                  if (u(i,j,k,URHO) <= castro::ambient_safety_factor * ambient::ambient_state[URHO]) {
+                      Real rhoInv = 1.0_rt / u(i,j,k,URHO);
+
+                      eos_rep_t eos_state;
+
+                      eos_state.rho = u(i,j,k,URHO);
+                      eos_state.T   = u(i,j,k,UTEMP);
+                      eos_state.e   = u(i,j,k,UEINT) * rhoInv;
+                      for (int n = 0; n < NumSpec; ++n) {
+                        eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+                      }
+#if NAUX_NET > 0
+                      for (int n = 0; n < NumAux; ++n) {
+                        eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+                      }
+#endif
+
+                      eos(eos_input_re, eos_state);
+
+                      cache(i,j,k,ECACHE_P) = eos_state.p;
+                      cache(i,j,k,ECACHE_CS) = eos_state.cs;
+                      cache(i,j,k,ECACHE_GAMC) = eos_state.gam1;
+                      cache(i,j,k,ECACHE_DPDR) = eos_state.dpdr_e;
+                      cache(i,j,k,ECACHE_DPDE) = eos_state.dpde;
+                  }
+              });
+          }
       }
   }
 
+  if (fill_eos_cache) {
+      eos_cache_valid = true;
+      eos_cache_time = state[State_Type].curTime();
+  }
+
 #ifdef TRUE_SDC
   if (sdc_order == 4) {
 
@@ -4163,6 +4596,8 @@ Castro::swap_state_time_levels(const Real dt)
 
     BL_PROFILE("Castro::swap_state_time_levels()");
 
+    invalidate_eos_cache();
+
     MultiFab::RegionTag statedata_tag("StateData_Level_" + std::to_string(level));
     MultiFab::RegionTag amrlevel_tag("AmrLevel_Level_" + std::to_string(level));
 
@@ -4489,6 +4924,23 @@ Castro::clean_state(
 
 }
 
+void
+Castro::record_retry_failed_boxes (const Gpu::DeviceVector<int>& box_failed)
+{
+    BL_PROFILE("Castro::record_retry_failed_boxes()");
+
+    AMREX_ASSERT(box_failed.size() == retry_failed_boxes.size());
+
+    Vector<int> h_box_failed(box_failed.size());
+    Gpu::copy(Gpu::deviceToHost, box_failed.begin(), box_failed.end(), h_box_failed.begin());
+
+    for (int i = 0; i < h_box_failed.size(); ++i) {
+        if (h_box_failed[i] > 0) {
+            retry_failed_boxes[i] = 1;
+        }
+    }
+}
+
 void
 Castro::save_data_for_retry ()
 {
@@ -140,6 +140,16 @@ Castro::initialize_do_advance (Real time, Real dt)
     }
 #endif
 
+    // The new-time state is about to be overwritten.
+
+    invalidate_eos_cache();
+
+    // Reset the record of which boxes failed, in case we need a local retry.
+
+    if (retry_local == 1 && retry_local_pass == 0) {
+        retry_failed_boxes.assign(grids.size(), 0);
+    }
+
     // For the hydrodynamics update we need to have NUM_GROW ghost
     // zones available, but the state data does not carry ghost
     // zones. So we use a FillPatch using the state data to give us
@@ -262,7 +272,12 @@ Castro::finalize_do_advance (Real time, Real dt)
 
     if (castro::time_integration_method == CornerTransportUpwind ||
         castro::time_integration_method == SimplifiedSpectralDeferredCorrections) {
-        if (castro::check_dt_after_advance) {
+        // The first pass of a local retry still contains the failed
+        // boxes, which will be replaced in the second pass, and the second
+        // pass is already taking subcycled timesteps, so skip the check then.
+        // local_retry_advance_ctu does it on the merged result instead.
+
+        if (castro::check_dt_after_advance && retry_local_pass == 0) {
 
             // But don't do this check if we're using simplified SDC and we're not yet
             // on the final SDC iteration, since we're not yet at the final advance.
@@ -560,7 +575,11 @@ Castro::initialize_advance(Real time, Real dt, int amr_iteration)
 #endif
 
 #ifdef REACTIONS
-    if (store_burn_weights == 1) {
+    // The batched burner sorts the zones using the burn weights from the
+    // last step, so in that case react_state resets them itself.
+
+    if (burn_weights.isDefined() &&
+        !(react_batched == 1 && time_integration_method == CornerTransportUpwind)) {
         burn_weights.setVal(0.0);
     }
 #endif
@@ -616,7 +635,11 @@ Castro::finalize_advance()
 
 #ifdef TRUE_SDC
     if (time_integration_method == SpectralDeferredCorrections) {
-      k_new.clear();
+      // the finer levels interpolate their coarse-fine ghost cells in
+      // time from our node states, so keep those until the next advance
+      if (level == parent->finestLevel()) {
+          k_new.clear();
+      }
       A_new.clear();
       A_old.clear();
 #ifdef REACTIONS
@@ -229,6 +229,549 @@ Castro::retry_advance_ctu(Real dt, const advance_status& status)
 
 
 
+advance_status
+Castro::local_retry_advance_ctu(const Real time, const Real dt, const advance_status& failed_status)
+{
+    BL_PROFILE("Castro::local_retry_advance_ctu()");
+
+    // We can only do a local retry if this level is being advanced on
+    // its own, and if all of the operators are local, so that the
+    // solution away from the failing boxes does not depend on them
+    // except through the hydrodynamic fluxes.
+
+    bool local_retry_possible = time_integration_method == CornerTransportUpwind;
+
+    if (parent->subcyclingMode() == "None" && level == 0 && parent->finestLevel() > 0) {
+        local_retry_possible = false;
+    }
+
+#if (AMREX_SPACEDIM <= 2)
+    if (!Geom().IsCartesian()) {
+        local_retry_possible = false;
+    }
+#endif
+
+#if defined(RADIATION) || defined(MHD)
+    local_retry_possible = false;
+#endif
+
+#ifdef GRAVITY
+    if (do_grav && gravity->get_gravity_type() != "ConstantGrav") {
+        local_retry_possible = false;
+    }
+#endif
+
+    if (!local_retry_possible || static_cast<int>(retry_failed_boxes.size()) != grids.size()) {
+        return failed_status;
+    }
+
+    ParallelDescriptor::ReduceIntMax(retry_failed_boxes.data(), static_cast<int>(retry_failed_boxes.size()));
+
+    // The failing boxes and the region to redo (the failing boxes plus
+    // a halo), including their periodic images so that the ghost zones
+    // of the retry mask are consistent.
+
+    const auto shifts = geom.periodicity().shiftIntVect();
+
+    BoxList failed_bl;
+    BoxList patch_bl;
+
+    for (int i = 0; i < grids.size(); ++i) {
+        if (retry_failed_boxes[i] == 0) {
+            continue;
+        }
+
+        for (const auto& iv : shifts) {
+            failed_bl.push_back(Box(grids[i]).shift(iv));
+            patch_bl.push_back(amrex::grow(grids[i], retry_local_halo).shift(iv));
+        }
+    }
+
+    if (failed_bl.isEmpty()) {
+        return failed_status;
+    }
+
+    BoxArray failed_ba(std::move(failed_bl));
+    BoxArray patch_ba(std::move(patch_bl));
+    patch_ba.removeOverlap();
+
+    Long patch_zones = 0;
+
+    for (int i = 0; i < patch_ba.size(); ++i) {
+        for (const auto& isect : grids.intersections(patch_ba[i])) {
+            patch_zones += isect.second.numPts();
+        }
+    }
+
+    if (static_cast<Real>(patch_zones) > retry_local_max_fraction * static_cast<Real>(grids.numPts())) {
+        return failed_status;
+    }
+
+    const Real strt_time = ParallelDescriptor::second();
+
+    if (verbose && ParallelDescriptor::IOProcessor()) {
+        std::cout << std::endl;
+        std::cout << Font::Bold << FGColor::Red;
+        std::cout << "  Timestep " << dt << " rejected at level " << level << "." << std::endl;
+        std::cout << "  Performing a local retry on " << patch_zones << " zones ("
+                  << 100.0_rt * static_cast<Real>(patch_zones) / static_cast<Real>(grids.numPts())
+                  << "% of the level)." << std::endl;
+        std::cout << ResetDisplay;
+        std::cout << std::endl;
+    }
+
+    // Build the retry mask (see retry_local_skip) and record which
+    // boxes touch the redone region (or are adjacent to it, so that
+    // both copies of the fluxes on the boundary of the region are
+    // computed in the second pass).
+
+    retry_local_mask.define(grids, dmap, 1, NUM_GROW);
+    retry_local_mask.setVal(0);
+
+    for (MFIter mfi(retry_local_mask); mfi.isValid(); ++mfi) {
+        const Box& fbx = mfi.fabbox();
+        auto& mask_fab = retry_local_mask[mfi];
+
+        for (const auto& isect : patch_ba.intersections(fbx)) {
+            mask_fab.setVal<RunOn::Device>(1, isect.second, 0, 1);
+        }
+
+        for (const auto& isect : failed_ba.intersections(fbx)) {
+            mask_fab.setVal<RunOn::Device>(2, isect.second, 0, 1);
+        }
+    }
+
+    retry_local_active_box.resize(grids.size());
+
+    for (int i = 0; i < grids.size(); ++i) {
+        retry_local_active_box[i] = patch_ba.intersects(amrex::grow(grids[i], 1)) ? 1 : 0;
+    }
+
+    // Keep a copy of the old data, so that we can restart the second
+    // pass if needed and restore it at the end.
+
+    Vector<std::unique_ptr<MultiFab>> old_data(num_state_type);
+
+    for (int k = 0; k < num_state_type; k++) {
+        if (state[k].hasOldData()) {
+            const MultiFab& old = state[k].oldData();
+            old_data[k] = std::make_unique<MultiFab>(old.boxArray(), old.DistributionMap(), old.nComp(), old.nGrow());
+            MultiFab::Copy(*old_data[k], old, 0, 0, old.nComp(), old.nGrow());
+        }
+    }
+
+    auto restore_old_data = [&] (Real prev_time, Real cur_time)
+    {
+        for (int k = 0; k < num_state_type; k++) {
+            if (old_data[k]) {
+                MultiFab& old = state[k].oldData();
+                MultiFab::Copy(old, *old_data[k], 0, 0, old.nComp(), old.nGrow());
+            }
+            state[k].setTimeLevel(cur_time, cur_time - prev_time, 0.0);
+        }
+
+        invalidate_eos_cache();
+    };
+
+    auto clear_fluxes = [&] ()
+    {
+        for (int dir = 0; dir < 3; ++dir) {
+            fluxes[dir]->setVal(0.0);
+            mass_fluxes[dir]->setVal(0.0);
+        }
+
+#ifdef REACTIONS
+        if (burn_weights.isDefined()) {
+            burn_weights.setVal(0.0);
+        }
+#endif
+    };
+
+    advance_status status {};
+
+    // First pass: redo the full timestep everywhere except in the
+    // failing boxes, where we neither burn nor check the solution.
+    // Since the halo is at least as wide as the hydro stencil, the
+    // solution outside of the halo is independent of the failing boxes.
+    // As in a regular retry, we keep the source corrector that was
+    // computed in the first attempt.
+
+    restore_old_data(time, time + dt);
+    clear_fluxes();
+
+    retry_local_pass = 1;
+
+    in_retry = true;
+    status = do_advance_ctu(time, dt);
+    in_retry = false;
+
+    // Save the result of the first pass.
+
+    Vector<std::unique_ptr<MultiFab>> new_data(num_state_type);
+    Vector<std::unique_ptr<MultiFab>> outer_fluxes(AMREX_SPACEDIM);
+    Vector<std::unique_ptr<MultiFab>> outer_mass_fluxes(AMREX_SPACEDIM);
+    MultiFab outer_burn_weights;
+
+    if (status.success) {
+
+        for (int k = 0; k < num_state_type; k++) {
+            const MultiFab& snew = state[k].newData();
+            new_data[k] = std::make_unique<MultiFab>(snew.boxArray(), snew.DistributionMap(), snew.nComp(), snew.nGrow());
+            MultiFab::Copy(*new_data[k], snew, 0, 0, snew.nComp(), snew.nGrow());
+        }
+
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            outer_fluxes[dir] = std::make_unique<MultiFab>(fluxes[dir]->boxArray(), dmap, NUM_STATE, 0);
+            MultiFab::Copy(*outer_fluxes[dir], *fluxes[dir], 0, 0, NUM_STATE, 0);
+
+            outer_mass_fluxes[dir] = std::make_unique<MultiFab>(mass_fluxes[dir]->boxArray(), dmap, 1, 0);
+            MultiFab::Copy(*outer_mass_fluxes[dir], *mass_fluxes[dir], 0, 0, 1, 0);
+        }
+
+#ifdef REACTIONS
+        if (burn_weights.isDefined()) {
+            outer_burn_weights.define(grids, dmap, burn_weights.nComp(), burn_weights.nGrow());
+            MultiFab::Copy(outer_burn_weights, burn_weights, 0, 0, burn_weights.nComp(), burn_weights.nGrow());
+        }
+#endif
+
+    }
+    else if (verbose) {
+        amrex::Print() << "  Local retry failed outside of the failing boxes with reason: " << status.reason << std::endl << std::endl;
+    }
+
+    // Second pass: subcycle the failing boxes plus halo. Outside of that
+    // region the state at the end of each subcycle is the result of the
+    // first pass, linearly interpolated in time, which provides the
+    // boundary conditions for the redone region. If a subcycle fails we
+    // start over with a smaller timestep.
+
+    Real dt_patch = dt * retry_subcycle_factor;
+
+    if (failed_status.suggested_dt > 0.0_rt && failed_status.suggested_dt < dt) {
+        dt_patch = failed_status.suggested_dt;
+    }
+
+    retry_local_pass = 2;
+
+    // Each subcycle overwrites mass_fluxes with its own fluxes, so we sum
+    // them over the subcycles, to get the mass fluxes of the full step.
+
+    Vector<std::unique_ptr<MultiFab>> inner_mass_fluxes(AMREX_SPACEDIM);
+
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        inner_mass_fluxes[dir] = std::make_unique<MultiFab>(mass_fluxes[dir]->boxArray(), dmap, 1, 0);
+    }
+
+    while (status.success) {
+
+        const int num_subcycles = amrex::max(1, static_cast<int>(std::ceil(dt / dt_patch - 1.e-12_rt)));
+
+        if (num_subcycles > max_subcycles) {
+            status.success = false;
+            status.reason = "too many subcycles in the local retry";
+            break;
+        }
+
+        const Real dt_sub = dt / static_cast<Real>(num_subcycles);
+
+        restore_old_data(time, time + dt_sub);
+        clear_fluxes();
+
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+            inner_mass_fluxes[dir]->setVal(0.0);
+        }
+
+        advance_status sub_status {};
+
+        for (int n = 0; n < num_subcycles; ++n) {
+
+            if (n > 0) {
+                swap_state_time_levels(0.0);
+
+#ifdef GRAVITY
+                if (do_grav) {
+                    gravity->swapTimeLevels(level);
+                }
+#endif
+            }
+
+            const Real t_sub = time + static_cast<Real>(n) * dt_sub;
+
+            for (int k = 0; k < num_state_type; k++) {
+                state[k].setTimeLevel(t_sub + dt_sub, dt_sub, 0.0);
+            }
+
+            in_retry = true;
+            sub_status = do_advance_ctu(t_sub, dt_sub);
+            in_retry = false;
+
+            if (!sub_status.success) {
+                break;
+            }
+
+            for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                MultiFab::Add(*inner_mass_fluxes[dir], *mass_fluxes[dir], 0, 0, 1, 0);
+            }
+
+            // Reset the state outside of the redone region.
+
+            const Real theta = static_cast<Real>(n + 1) / static_cast<Real>(num_subcycles);
+
+            MultiFab& S_new = get_new_data(State_Type);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.tilebox();
+
+                auto snew = S_new.array(mfi);
+                auto sold = old_data[State_Type]->const_array(mfi);
+                auto souter = new_data[State_Type]->const_array(mfi);
+                auto mask = retry_local_mask.const_array(mfi);
+
+                amrex::ParallelFor(bx, NUM_STATE,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int comp) noexcept
+                {
+                    if (mask(i,j,k) == 0) {
+                        snew(i,j,k,comp) = (1.0_rt - theta) * sold(i,j,k,comp) + theta * souter(i,j,k,comp);
+                    }
+                });
+            }
+
+        }
+
+        if (sub_status.success) {
+            break;
+        }
+
+        dt_patch = dt_sub * retry_subcycle_factor;
+
+        if (sub_status.suggested_dt > 0.0_rt && sub_status.suggested_dt < dt_sub) {
+            dt_patch = sub_status.suggested_dt;
+        }
+
+        if (verbose) {
+            amrex::Print() << "  Local retry subcycle was unsuccessful with reason: " << sub_status.reason
+                           << "; trying again with dt = " << dt_patch << std::endl << std::endl;
+        }
+
+    }
+
+    if (status.success) {
+
+        // Combine the two passes. Outside of the redone region we keep the
+        // first pass, except that the zones adjacent to the redone region
+        // are corrected for the difference between the fluxes through
+        // their faces in the two passes, so that the update is conservative.
+        // The fluxes (which are used for the reflux) are then the ones
+        // each zone has seen.
+
+        MultiFab& S_new = get_new_data(State_Type);
+
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+
+            const int il = dir == 0 ? 1 : 0;
+            const int jl = dir == 1 ? 1 : 0;
+            const int kl = dir == 2 ? 1 : 0;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.tilebox();
+
+                auto snew = S_new.array(mfi);
+                auto flux_inner = fluxes[dir]->const_array(mfi);
+                auto flux_outer = outer_fluxes[dir]->const_array(mfi);
+                auto mask = retry_local_mask.const_array(mfi);
+                auto vol = volume.const_array(mfi);
+
+                amrex::ParallelFor(bx, NUM_STATE,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int comp) noexcept
+                {
+                    if (mask(i,j,k) != 0) {
+                        return;
+                    }
+
+                    Real dU = 0.0_rt;
+
+                    if (mask(i-il,j-jl,k-kl) != 0) {
+                        dU += flux_inner(i,j,k,comp) - flux_outer(i,j,k,comp);
+                    }
+
+                    if (mask(i+il,j+jl,k+kl) != 0) {
+                        dU -= flux_inner(i+il,j+jl,k+kl,comp) - flux_outer(i+il,j+jl,k+kl,comp);
+                    }
+
+                    snew(i,j,k,comp) += dU / vol(i,j,k);
+                });
+            }
+
+        }
+
+        for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+
+            const int il = dir == 0 ? 1 : 0;
+            const int jl = dir == 1 ? 1 : 0;
+            const int kl = dir == 2 ? 1 : 0;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(*fluxes[dir], TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& nbx = mfi.tilebox();
+
+                auto flux_inner = fluxes[dir]->array(mfi);
+                auto flux_outer = outer_fluxes[dir]->const_array(mfi);
+                auto mask = retry_local_mask.const_array(mfi);
+
+                amrex::ParallelFor(nbx, NUM_STATE,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int comp) noexcept
+                {
+                    if (mask(i-il,j-jl,k-kl) == 0 && mask(i,j,k) == 0) {
+                        flux_inner(i,j,k,comp) = flux_outer(i,j,k,comp);
+                    }
+                });
+            }
+
+            // The same for the mass fluxes, which are used by the
+            // conservative gravity and rotation source corrections.
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(*mass_fluxes[dir], TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& nbx = mfi.tilebox();
+
+                auto mflux = mass_fluxes[dir]->array(mfi);
+                auto mflux_inner = inner_mass_fluxes[dir]->const_array(mfi);
+                auto mflux_outer = outer_mass_fluxes[dir]->const_array(mfi);
+                auto mask = retry_local_mask.const_array(mfi);
+
+                amrex::ParallelFor(nbx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    if (mask(i-il,j-jl,k-kl) == 0 && mask(i,j,k) == 0) {
+                        mflux(i,j,k) = mflux_outer(i,j,k);
+                    } else {
+                        mflux(i,j,k) = mflux_inner(i,j,k);
+                    }
+                });
+            }
+
+        }
+
+        // Every other state type (and the burn weights) is simply taken from
+        // the pass in which the zone was advanced.
+
+        for (int st = 0; st < num_state_type; st++) {
+
+            MultiFab& snew = state[st].newData();
+
+            if (st == State_Type || snew.ixType() != IndexType::TheCellType()) {
+                continue;
+            }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(snew, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.tilebox();
+
+                auto snew_arr = snew.array(mfi);
+                auto souter = new_data[st]->const_array(mfi);
+                auto mask = retry_local_mask.const_array(mfi);
+
+                amrex::ParallelFor(bx, snew.nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int comp) noexcept
+                {
+                    if (mask(i,j,k) == 0) {
+                        snew_arr(i,j,k,comp) = souter(i,j,k,comp);
+                    }
+                });
+            }
+
+        }
+
+#ifdef REACTIONS
+        if (burn_weights.isDefined()) {
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(burn_weights, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.tilebox();
+
+                auto weights = burn_weights.array(mfi);
+                auto outer_weights = outer_burn_weights.const_array(mfi);
+                auto mask = retry_local_mask.const_array(mfi);
+
+                amrex::ParallelFor(bx, burn_weights.nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int comp) noexcept
+                {
+                    if (mask(i,j,k) == 0) {
+                        weights(i,j,k,comp) = outer_weights(i,j,k,comp);
+                    }
+                });
+            }
+
+        }
+#endif
+
+        // Make the corrected zones thermodynamically consistent.
+
+        clean_state(S_new, time + dt, 0);
+
+        // The passes skip the post-advance timestep check (the first
+        // still contains the failed boxes), so do it on the merged result.
+
+        if (castro::check_dt_after_advance) {
+            int is_new = 1;
+            Real new_dt = estTimeStep(is_new);
+
+            if (castro::change_max * new_dt < dt) {
+                status.success = false;
+                status.reason = "post-advance timestep validity check failed";
+            }
+        }
+
+        if (verbose && status.success) {
+            amrex::Print() << "  Local retry completed successfully." << std::endl << std::endl;
+        }
+
+    }
+
+    if (!status.success && verbose) {
+        amrex::Print() << "  Local retry was unsuccessful; falling back to a retry of the whole level." << std::endl << std::endl;
+    }
+
+    // Restore the original old data and time levels, so that this looks
+    // like a single advance from time to time + dt (or, if we failed,
+    // so that the global retry starts from the right data).
+
+    restore_old_data(time, time + dt);
+
+    retry_local_pass = 0;
+    retry_local_mask.clear();
+
+    if (verbose > 0) {
+        Real run_time = ParallelDescriptor::second() - strt_time;
+        ParallelDescriptor::ReduceRealMax(run_time, ParallelDescriptor::IOProcessorNumber());
+
+        amrex::Print() << "Castro::local_retry_advance_ctu() time = " << run_time << " on level " << level << "\n" << "\n";
+    }
+
+    if (!status.success) {
+        return failed_status;
+    }
+
+    return status;
+}
+
+
+
 Real
 Castro::subcycle_advance_ctu(const Real time, const Real dt, int amr_iteration, int amr_ncycle)
 {
@@ -414,6 +957,13 @@ Castro::subcycle_advance_ctu(const Real time, const Real dt, int amr_iteration,
 
         sdc_iters = sdc_iters_old;
 
+        // If the advance failed, first see whether we can get away with
+        // redoing only the part of the level where the failure occurred.
+
+        if (!status.success && use_retry && retry_local == 1) {
+            status = local_retry_advance_ctu(subcycle_time, dt_subcycle, status);
+        }
+
         // If we're allowing for retries, check for that here.
 
         if (use_retry) {
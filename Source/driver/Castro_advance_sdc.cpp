@@ -45,6 +45,12 @@ Castro::do_advance_sdc (Real time,
 
   advance_status status {};
 
+  // The SDC advance only updates this level, so without subcycling
+  // the finer levels would never be advanced.
+  if (level == 0 && parent->finestLevel() > 0 && parent->subcyclingMode() == "None") {
+      amrex::Error("true SDC with AMR requires subcycling (amr.subcycling_mode != None)");
+  }
+
   // Perform initialization steps.
 
   status = initialize_do_advance(time, dt);
@@ -68,12 +74,11 @@ Castro::do_advance_sdc (Real time,
     Real node_time = time + dt_sdc[m]*dt;
 
     // fill Sborder with the starting node's info -- we use S_new as
-    // our staging area.  Note we need to pass new_time here to the
-    // FillPatch so it only pulls from the new MF -- this will not
-    // work for multilevel.
+    // our staging area.  On fine levels, the coarse-fine ghost cells
+    // are interpolated to the node time from the coarse SDC nodes.
     MultiFab::Copy(S_new, *(k_new[m]), 0, 0, S_new.nComp(), 0);
     clean_state(S_new, cur_time, 0);
-    expand_state(Sborder, cur_time, NUM_GROW);
+    expand_sdc_node_state(Sborder, node_time, NUM_GROW);
 
 
     // the next chunk of code constructs the advective term for the
@@ -111,9 +116,12 @@ Castro::do_advance_sdc (Real time,
           // fill the ghost cells for the sources -- note since we have
           // not defined the new_source yet, we either need to copy this
           // into new_source for the time-interpolation in the ghost
-          // fill to make sense, or so long as we are not multilevel,
-          // just use the old time (prev_time) in the fill instead of
-          // the node time (time)
+          // fill to make sense, or just use the old time (prev_time)
+          // in the fill instead of the node time (time).  We do the
+          // latter; on fine levels this means the coarse-fine ghost
+          // cells hold the coarse source interpolated to prev_time,
+          // which only enters the conversion to averages at the
+          // coarse-fine boundary.
           AmrLevel::FillPatch(*this, old_source, old_source.nGrow(), prev_time, Source_Type, 0, NSRC);
 
           // Now convert to cell averages.  This loop cannot be tiled.
@@ -233,7 +241,7 @@ Castro::do_advance_sdc (Real time,
   for (int m = 1; m < SDC_NODES; ++m) {
     // TODO: do we need a clean state here?
     MultiFab::Copy(S_new, *(k_new[m]), 0, 0, S_new.nComp(), 0);
-    expand_state(Sburn, cur_time, 2);
+    expand_sdc_node_state(Sburn, time + dt_sdc[m]*dt, 2);
     bool input_is_average = true;
     construct_old_react_source(Sburn, *(R_old[m]), input_is_average);
   }
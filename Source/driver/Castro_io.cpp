@@ -9,6 +9,7 @@
 #include <ctime>
 
 #include <AMReX_Utility.H>
+#include <AMReX_AsyncOut.H>
 #include <Castro.H>
 #include <Castro_io.H>
 #include <AMReX_ParmParse.H>
@@ -60,6 +61,22 @@ namespace
 {
     int input_version = -1;
     int current_version = 12;
+
+    // With asynchronous output, the final name of the checkpoint that is
+    // still being written (its CastroHeader is only written once it is
+    // complete).
+    std::string pending_checkpoint_dir;
+
+    void write_castro_header (const std::string& dir)
+    {
+        std::ofstream CastroHeaderFile;
+        std::string FullPathCastroHeaderFile = dir;
+        FullPathCastroHeaderFile += "/CastroHeader";
+        CastroHeaderFile.open(FullPathCastroHeaderFile.c_str(), std::ios::out);
+
+        CastroHeaderFile << "Checkpoint version: " << current_version << std::endl;
+        CastroHeaderFile.close();
+    }
 }
 
 // I/O routines for Castro
@@ -90,7 +107,13 @@ Castro::restart (Amr&     papa,
         ParallelDescriptor::Bcast(&input_version, 1, ParallelDescriptor::IOProcessorNumber());
     }
 
-    // Check that the version number matches.
+    // Check that the version number matches. Since the CastroHeader is the
+    // last file written in an asynchronous checkpoint, a missing one may
+    // also mean that the checkpoint was never completed.
+
+    if (input_version == 0) {
+        amrex::Error("Checkpoint has no CastroHeader: it is either incomplete or from an incompatible version of the code");
+    }
 
     if (input_version != current_version) {
         amrex::Error("Checkpoint format incompatible with current code");
@@ -206,6 +229,42 @@ Castro::restart (Amr&     papa,
     }
 #endif
 
+    if (level == 0)
+    {
+        // If we are tuning the hydro tile size, reuse the tile size
+        // from the run that wrote this checkpoint, if it was tuned.
+
+#ifdef AMREX_USE_GPU
+        const bool tune_tile_size = castro::hydro_memory_footprint_ratio > 0.0;
+#else
+        const bool tune_tile_size = castro::hydro_tile_size_tuning == 1;
+#endif
+
+        if (tune_tile_size) {
+            std::ifstream TileFile;
+            std::string FullPathTileFile = parent->theRestartFile();
+            FullPathTileFile += "/HydroTileSize";
+            TileFile.open(FullPathTileFile.c_str(), std::ios::in);
+
+            if (TileFile.good()) {
+                IntVect tile_size;
+                Long largest_box;
+                TileFile >> tile_size >> largest_box;
+
+                if (TileFile) {
+                    hydro_tile_size = tile_size;
+                    largest_box_from_hydro_tile_size_tuning = largest_box;
+                    hydro_tile_size_has_been_tuned = 1;
+
+                    amrex::Print() << "  Based on the checkpoint, setting the hydro tile size to "
+                                   << hydro_tile_size << "\n";
+                }
+
+                TileFile.close();
+            }
+        }
+    }
+
     if (level == 0)
     {
         // get problem-specific stuff -- note all processors do this,
@@ -387,6 +446,21 @@ Castro::checkPoint(const std::string& dir,
                    bool /*dump_old_default*/)
 {
 
+  // With asynchronous output (amrex.async_out = 1) the state data and
+  // particles are copied to host buffers and written by a background
+  // thread, so that we can return to the evolution right away. Before
+  // starting a new checkpoint, make sure the last one was completed.
+
+  const bool async_checkpoint = amrex::AsyncOut::UseAsyncOut();
+
+  if (level == 0) {
+      finish_async_checkpoint();
+
+      // Make sure the diagnostics up to this point are on disk along
+      // with the checkpoint.
+      flush_binary_data_logs();
+  }
+
   const Real io_start_time = ParallelDescriptor::second();
 
   AmrLevel::checkPoint(dir, os, how, dump_old);
@@ -405,17 +479,18 @@ Castro::checkPoint(const std::string& dir,
 
   if (level == 0 && ParallelDescriptor::IOProcessor())
     {
-        {
-            std::ofstream CastroHeaderFile;
-            std::string FullPathCastroHeaderFile = dir;
-            FullPathCastroHeaderFile += "/CastroHeader";
-            CastroHeaderFile.open(FullPathCastroHeaderFile.c_str(), std::ios::out);
+        // The small files are written right away, rather than on the
+        // background thread, since Amr renames the checkpoint directory
+        // as soon as we return. With asynchronous output, the
+        // CastroHeader is written by finish_async_checkpoint.
 
-            CastroHeaderFile << "Checkpoint version: " << current_version << std::endl;
-            CastroHeaderFile.close();
+        if (!async_checkpoint) {
+            write_castro_header(dir);
+        }
 
-            writeJobInfo(dir, io_time);
+        writeJobInfo(dir, io_time);
 
+        {
             // output the list of state variables, so we can do a sanity check on restart
             std::ofstream StateListFile;
             std::string FullPathStateList = dir;
@@ -489,12 +564,77 @@ Castro::checkPoint(const std::string& dir,
         }
 #endif
 
+        if (hydro_tile_size_has_been_tuned == 1) {
+            // store the tuned hydro tile size, so that a restart
+            // does not need to redo the tuning
+            std::ofstream TileFile;
+            std::string FullPathTileFile = dir;
+            FullPathTileFile += "/HydroTileSize";
+            TileFile.open(FullPathTileFile.c_str(), std::ios::out);
+
+            TileFile << hydro_tile_size << "\n" << largest_box_from_hydro_tile_size_tuning << std::endl;
+
+            TileFile.close();
+        }
+
         {
             // store any problem-specific stuff
             problem_checkpoint(dir);
         }
     }
 
+  // Amr writes the checkpoint into dir (which has a ".temp" suffix) and
+  // renames it to its final name once all the levels are done, which
+  // will be before the background writes finish, so the CastroHeader
+  // goes into the renamed directory.
+
+  if (level == 0 && async_checkpoint) {
+      const std::string temp_suffix = ".temp";
+
+      pending_checkpoint_dir = dir;
+
+      if (pending_checkpoint_dir.size() > temp_suffix.size() &&
+          pending_checkpoint_dir.compare(pending_checkpoint_dir.size() - temp_suffix.size(),
+                                         temp_suffix.size(), temp_suffix) == 0) {
+          pending_checkpoint_dir.erase(pending_checkpoint_dir.size() - temp_suffix.size());
+      }
+  }
+
+}
+
+void
+Castro::finish_async_checkpoint ()
+{
+    if (pending_checkpoint_dir.empty()) {
+        return;
+    }
+
+    BL_PROFILE("Castro::finish_async_checkpoint()");
+
+    const Real strt_time = ParallelDescriptor::second();
+
+    // Wait until this rank's writes are done, and then until every
+    // rank's writes are done, before marking the checkpoint as complete
+    // by writing the CastroHeader. A checkpoint without a CastroHeader
+    // cannot be used for a restart.
+
+    amrex::AsyncOut::Finish();
+
+    ParallelDescriptor::Barrier();
+
+    if (ParallelDescriptor::IOProcessor()) {
+        write_castro_header(pending_checkpoint_dir);
+    }
+
+    if (verbose > 0) {
+        Real run_time = ParallelDescriptor::second() - strt_time;
+        ParallelDescriptor::ReduceRealMax(run_time, ParallelDescriptor::IOProcessorNumber());
+
+        amrex::Print() << "Completed the asynchronous checkpoint " << pending_checkpoint_dir
+                       << " (waited " << run_time << " seconds)" << std::endl;
+    }
+
+    pending_checkpoint_dir.clear();
 }
 
 std::string
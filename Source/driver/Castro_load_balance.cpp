@@ -0,0 +1,111 @@
+#include <Castro.H>
+
+#include <AMReX_Amr.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_LayoutData.H>
+
+using namespace amrex;
+
+void
+Castro::compute_box_costs (LayoutData<Real>& cost)
+{
+    BL_PROFILE("Castro::compute_box_costs()");
+
+    // Every zone gets charged for the hydro update, and zones that
+    // burned additionally get charged for the number of RHS
+    // evaluations (and Jacobians) the integrator needed the last time
+    // it was called on this level.
+
+    for (MFIter mfi(cost); mfi.isValid(); ++mfi) {
+
+        const Box& bx = mfi.validbox();
+
+        Real box_cost = load_balance_hydro_weight * static_cast<Real>(bx.numPts());
+
+#ifdef REACTIONS
+        if (burn_weights.isDefined()) {
+            box_cost += burn_weights[mfi].sum<RunOn::Device>(bx, 0, burn_weights.nComp());
+        }
+#endif
+
+        cost[mfi] = box_cost;
+    }
+}
+
+void
+Castro::load_balance (Amr* amr)
+{
+    if (load_balance_int <= 0) {
+        return;
+    }
+
+    if (amr->levelSteps(0) % load_balance_int != 0) {
+        return;
+    }
+
+    BL_PROFILE("Castro::load_balance()");
+
+    const Real strt_time = ParallelDescriptor::second();
+
+    const int finest_level = amr->finestLevel();
+
+    int lbase = finest_level + 1;
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+
+        auto& castro = dynamic_cast<Castro&>(amr->getLevel(lev));
+
+        LayoutData<Real> cost(castro.boxArray(), castro.DistributionMap());
+
+        castro.compute_box_costs(cost);
+
+        Real current_efficiency = 0.0_rt;
+        Real proposed_efficiency = 0.0_rt;
+
+        DistributionMapping new_dmap;
+
+        if (load_balance_strategy == 0) {
+            new_dmap = DistributionMapping::makeKnapSack(cost, current_efficiency, proposed_efficiency);
+        } else if (load_balance_strategy == 1) {
+            new_dmap = DistributionMapping::makeSFC(cost, current_efficiency, proposed_efficiency);
+        } else {
+            amrex::Error("Unknown castro.load_balance_strategy");
+        }
+
+        const bool install = proposed_efficiency > load_balance_efficiency_threshold * current_efficiency;
+
+        if (verbose > 0) {
+            amrex::Print() << "... load balance on level " << lev
+                           << ": current efficiency = " << current_efficiency
+                           << ", proposed efficiency = " << proposed_efficiency
+                           << (install ? " (installing new mapping)" : " (keeping current mapping)")
+                           << std::endl;
+        }
+
+        if (install) {
+            // This replaces the Castro object on this level with a new
+            // one that is filled from the old one via Castro::init(old),
+            // so castro is no longer valid after this call.
+            amr->InstallNewDistributionMap(lev, new_dmap);
+            lbase = amrex::min(lbase, lev);
+        }
+
+    }
+
+    // The new levels need the same post-processing that they would get
+    // after a regrid (e.g. redistributing particles and recomputing the
+    // Poisson gravity fields, which are not part of the state data).
+
+    if (lbase <= finest_level) {
+        for (int lev = lbase; lev <= finest_level; ++lev) {
+            dynamic_cast<Castro&>(amr->getLevel(lev)).post_regrid(lbase, finest_level);
+        }
+    }
+
+    if (verbose > 0) {
+        Real run_time = ParallelDescriptor::second() - strt_time;
+        ParallelDescriptor::ReduceRealMax(run_time, ParallelDescriptor::IOProcessorNumber());
+
+        amrex::Print() << "Castro::load_balance() time = " << run_time << "\n" << "\n";
+    }
+}
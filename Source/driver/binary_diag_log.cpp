@@ -0,0 +1,163 @@
+#include <binary_diag_log.H>
+
+#include <AMReX.H>
+#include <AMReX_Utility.H>
+
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+using namespace amrex;
+
+namespace {
+    const char magic[8] = {'C', 'A', 'S', 'T', 'R', 'O', 'D', 'L'};
+    const std::uint32_t byte_order_mark = 0x01020304;
+
+    template <typename T>
+    void append_bytes (std::vector<char>& buf, const T& value)
+    {
+        const char* p = reinterpret_cast<const char*>(&value);
+        buf.insert(buf.end(), p, p + sizeof(T));
+    }
+}
+
+BinaryDiagLog::BinaryDiagLog (std::string filename, std::size_t buffer_bytes)
+    : m_filename(std::move(filename)),
+      m_buffer_bytes(buffer_bytes)
+{
+    m_buffer.reserve(m_buffer_bytes);
+}
+
+BinaryDiagLog::~BinaryDiagLog ()
+{
+    flush();
+}
+
+void
+BinaryDiagLog::add (const std::string& name, Long value)
+{
+    const auto v = static_cast<std::int64_t>(value);
+    add_column(name, int_type, &v);
+}
+
+void
+BinaryDiagLog::add (const std::string& name, Real value)
+{
+    const auto v = static_cast<double>(value);
+    add_column(name, real_type, &v);
+}
+
+void
+BinaryDiagLog::add_column (const std::string& name, std::uint8_t type, const void* value)
+{
+    if (!m_schema_defined) {
+        m_names.push_back(name);
+        m_types.push_back(type);
+    }
+    else if (m_column >= static_cast<int>(m_names.size()) ||
+             m_names[m_column] != name || m_types[m_column] != type) {
+        amrex::Abort("BinaryDiagLog: column " + name + " does not match the schema of " + m_filename);
+    }
+
+    const char* p = static_cast<const char*>(value);
+    m_buffer.insert(m_buffer.end(), p, p + 8);
+
+    ++m_column;
+}
+
+void
+BinaryDiagLog::end_row ()
+{
+    if (!m_schema_defined) {
+        m_schema_defined = true;
+    }
+    else if (m_column != static_cast<int>(m_names.size())) {
+        amrex::Abort("BinaryDiagLog: wrong number of columns in a row of " + m_filename);
+    }
+
+    m_column = 0;
+
+    if (m_buffer.size() >= m_buffer_bytes) {
+        flush();
+    }
+}
+
+void
+BinaryDiagLog::write_or_check_header ()
+{
+    std::vector<char> header;
+
+    header.insert(header.end(), magic, magic + 8);
+    append_bytes(header, byte_order_mark);
+    append_bytes(header, version);
+    append_bytes(header, static_cast<std::uint32_t>(m_names.size()));
+
+    for (std::size_t n = 0; n < m_names.size(); ++n) {
+        append_bytes(header, m_types[n]);
+        append_bytes(header, static_cast<std::uint32_t>(m_names[n].size()));
+        header.insert(header.end(), m_names[n].begin(), m_names[n].end());
+    }
+
+    // If the file already has data in it (e.g. we restarted), we
+    // append to it, but only if it was written with the same schema.
+
+    std::ifstream existing(m_filename, std::ios::in | std::ios::binary);
+
+    if (existing.good()) {
+        existing.seekg(0, std::ios::end);
+        const auto existing_size = static_cast<std::size_t>(existing.tellg());
+
+        if (existing_size > 0) {
+            std::vector<char> existing_header(header.size());
+            existing.seekg(0, std::ios::beg);
+            if (existing_size < header.size() ||
+                !existing.read(existing_header.data(), static_cast<std::streamsize>(header.size())) ||
+                std::memcmp(existing_header.data(), header.data(), header.size()) != 0) {
+                amrex::Abort("BinaryDiagLog: " + m_filename + " exists but has a different set of columns;"
+                             " please move it out of the way");
+            }
+            m_header_done = true;
+            return;
+        }
+    }
+
+    std::ofstream out(m_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.good()) {
+        amrex::FileOpenFailed(m_filename);
+    }
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    m_header_done = true;
+}
+
+void
+BinaryDiagLog::flush ()
+{
+    // Only write complete rows; a row that is in progress stays in
+    // the buffer.
+
+    const std::size_t row_bytes = 8 * m_names.size();
+
+    if (!m_schema_defined || row_bytes == 0) {
+        return;
+    }
+
+    const std::size_t nbytes = (m_buffer.size() / row_bytes) * row_bytes;
+
+    if (nbytes == 0) {
+        return;
+    }
+
+    if (!m_header_done) {
+        write_or_check_header();
+    }
+
+    std::ofstream out(m_filename, std::ios::out | std::ios::binary | std::ios::app);
+    if (!out.good()) {
+        amrex::FileOpenFailed(m_filename);
+    }
+    out.write(m_buffer.data(), static_cast<std::streamsize>(nbytes));
+    out.flush();
+
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(nbytes));
+}
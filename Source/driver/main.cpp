@@ -171,6 +171,11 @@ main (int   argc,
         // Do a timestep.
         //
         amrptr->coarseTimeStep(stop_time);
+
+        //
+        // Optionally redistribute the boxes based on their measured cost.
+        //
+        Castro::load_balance(amrptr);
     }
 
 #ifdef DO_PROBLEM_POST_SIMULATION
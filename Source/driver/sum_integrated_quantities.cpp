@@ -19,8 +19,6 @@ Castro::sum_integrated_quantities ()
 
     BL_PROFILE("Castro::sum_integrated_quantities()");
 
-    bool local_flag = true;
-
     int finest_level = parent->finestLevel();
     Real time        = state[State_Type].curTime();
     Real dt          = parent->dtLevel(0);
@@ -54,45 +52,91 @@ Castro::sum_integrated_quantities ()
     int fixwidth     = 25; // Floating point data not in scientific notation
     int intwidth     = 12; // Integer data
 
-    for (int lev = 0; lev <= finest_level; lev++)
-    {
-        Castro& ca_lev = getLevel(lev);
-        MultiFab& S_new = ca_lev.get_new_data(State_Type);
-#ifdef GRAVITY
-        MultiFab& phi_new = ca_lev.get_new_data(PhiGrav_Type);
-#endif
-#ifdef REACTIONS
-        MultiFab& R_new = ca_lev.get_new_data(Reactions_Type);
-#endif
+    // All of the volume weighted sums are computed in a single pass over
+    // each level, and then reduced over all processes at once.
+
+    Vector<sum_quantity> quantities;
+
+    const int i_mass = static_cast<int>(quantities.size());
+    quantities.push_back({sum_quantity::StateComp, URHO, 0});
 
-        mass   += ca_lev.volWgtSum(S_new, URHO, local_flag);
-        mom[0] += ca_lev.volWgtSum(S_new, UMX, local_flag);
-        mom[1] += ca_lev.volWgtSum(S_new, UMY, local_flag);
-        mom[2] += ca_lev.volWgtSum(S_new, UMZ, local_flag);
+    const int i_mom = static_cast<int>(quantities.size());
+    quantities.push_back({sum_quantity::StateComp, UMX, 0});
+    quantities.push_back({sum_quantity::StateComp, UMY, 0});
+    quantities.push_back({sum_quantity::StateComp, UMZ, 0});
 
-        ang_mom[0] += ca_lev.volWgtSum("angular_momentum_x", time, local_flag);
-        ang_mom[1] += ca_lev.volWgtSum("angular_momentum_y", time, local_flag);
-        ang_mom[2] += ca_lev.volWgtSum("angular_momentum_z", time, local_flag);
+    const int i_ang_mom = static_cast<int>(quantities.size());
+    for (int idir = 0; idir < 3; idir++) {
+        quantities.push_back({sum_quantity::AngMom, 0, idir});
+    }
 
 #ifdef HYBRID_MOMENTUM
-        hyb_mom[0] += ca_lev.volWgtSum(S_new, UMR, time, local_flag);
-        hyb_mom[1] += ca_lev.volWgtSum(S_new, UML, time, local_flag);
-        hyb_mom[2] += ca_lev.volWgtSum(S_new, UMP, time, local_flag);
+    const int i_hyb_mom = static_cast<int>(quantities.size());
+    quantities.push_back({sum_quantity::StateComp, UMR, 0});
+    quantities.push_back({sum_quantity::StateComp, UML, 0});
+    quantities.push_back({sum_quantity::StateComp, UMP, 0});
 #endif
 
-        com[0] += ca_lev.locWgtSum(S_new, URHO, 0, local_flag);
-        com[1] += ca_lev.locWgtSum(S_new, URHO, 1, local_flag);
-        com[2] += ca_lev.locWgtSum(S_new, URHO, 2, local_flag);
+    const int i_com = static_cast<int>(quantities.size());
+    for (int idir = 0; idir < 3; idir++) {
+        quantities.push_back({sum_quantity::LocWgt, URHO, idir});
+    }
+
+    const int i_rho_e = static_cast<int>(quantities.size());
+    quantities.push_back({sum_quantity::StateComp, UEINT, 0});
+
+    const int i_rho_K = static_cast<int>(quantities.size());
+    quantities.push_back({sum_quantity::KinEng, 0, 0});
+
+    const int i_rho_E = static_cast<int>(quantities.size());
+    quantities.push_back({sum_quantity::StateComp, UEDEN, 0});
 
-        rho_e += ca_lev.volWgtSum(S_new, UEINT, local_flag);
-        rho_K += ca_lev.volWgtSum("kineng", time, local_flag);
-        rho_E += ca_lev.volWgtSum(S_new, UEDEN, local_flag);
 #ifdef GRAVITY
-        if (gravity->get_gravity_type() == "PoissonGrav") {
-            rho_phi += ca_lev.volProductSum(S_new, phi_new, URHO, 0, local_flag);
+    const std::string gravity_type = gravity->get_gravity_type();
+
+    const bool do_rho_phi = gravity_type == "PoissonGrav" || gravity_type == "MultipoleGrav";
+
+    const int i_rho_phi = static_cast<int>(quantities.size());
+    if (do_rho_phi) {
+        quantities.push_back({sum_quantity::PhiProduct, URHO, 0});
+    }
+
+    // Second time derivative of the quadrupole moment, for the
+    // gravitational wave strain.
+
+#if (AMREX_SPACEDIM > 1)
+    const bool do_gw = castro::gw_dist > 0.0_rt;
+#else
+    const bool do_gw = false;
+#endif
+
+    const int i_Qtt = static_cast<int>(quantities.size());
+    if (do_gw) {
+        for (int n = 0; n < 9; ++n) {
+            quantities.push_back({sum_quantity::Quadrupole, 0, n});
         }
+    }
 #endif
 
+    const int i_species = static_cast<int>(quantities.size());
+    for (int i = 0; i < NumSpec; ++i) {
+        quantities.push_back({sum_quantity::StateComp, UFS + i, 0});
+    }
+
+    const int nsums = static_cast<int>(quantities.size());
+
+    Vector<Real> sums(nsums, 0.0_rt);
+
+    for (int lev = 0; lev <= finest_level; lev++)
+    {
+        Castro& ca_lev = getLevel(lev);
+        MultiFab& S_new = ca_lev.get_new_data(State_Type);
+#ifdef REACTIONS
+        MultiFab& R_new = ca_lev.get_new_data(Reactions_Type);
+#endif
+
+        ca_lev.volWgtSums(quantities, sums.dataPtr(), time);
+
         // Compute extrema
 
 #ifdef REACTIONS
@@ -190,75 +234,42 @@ Castro::sum_integrated_quantities ()
 
     }
 
-    if (verbose > 0)
-    {
+    // The sums are also used for the gravitational wave strain and the
+    // species masses below, so they are always reduced.
 
-#ifdef HYBRID_MOMENTUM
-#ifdef GRAVITY
-       const int nfoo = 17;
-#else
-       const int nfoo = 16;
-#endif
-#else
-#ifdef GRAVITY
-       const int nfoo = 14;
-#else
-       const int nfoo = 13;
-#endif
-#endif
+    ParallelDescriptor::ReduceRealSum(sums.dataPtr(), nsums, ParallelDescriptor::IOProcessorNumber());
 
-        Real foo[nfoo] = {mass, mom[0], mom[1], mom[2],
-                          com[0], com[1], com[2],
-                          ang_mom[0], ang_mom[1], ang_mom[2],
-#ifdef HYBRID_MOMENTUM
-                          hyb_mom[0], hyb_mom[1], hyb_mom[2],
-#endif
-#ifdef GRAVITY
-                          rho_e, rho_K, rho_E, rho_phi};
-#else
-                          rho_e, rho_K, rho_E};
-#endif
+    if (verbose > 0)
+    {
 
         const int nfoo_max = 3;
 
         Real foo_max[nfoo_max] = {T_max, rho_max, ts_te_max};
 
-#ifdef BL_LAZY
-        Lazy::QueueReduction( [=] () mutable {
-#endif
-
-        ParallelDescriptor::ReduceRealSum(foo, nfoo, ParallelDescriptor::IOProcessorNumber());
-
         ParallelDescriptor::ReduceRealMax(foo_max, nfoo_max, ParallelDescriptor::IOProcessorNumber());
 
         if (ParallelDescriptor::IOProcessor()) {
 
-            int i = 0;
-            mass       = foo[i++];
-            mom[0]     = foo[i++];
-            mom[1]     = foo[i++];
-            mom[2]     = foo[i++];
-            com[0]     = foo[i++];
-            com[1]     = foo[i++];
-            com[2]     = foo[i++];
-            ang_mom[0] = foo[i++];
-            ang_mom[1] = foo[i++];
-            ang_mom[2] = foo[i++];
+            mass       = sums[i_mass];
+            for (int idir = 0; idir < 3; idir++) {
+                mom[idir]     = sums[i_mom + idir];
+                com[idir]     = sums[i_com + idir];
+                ang_mom[idir] = sums[i_ang_mom + idir];
 #ifdef HYBRID_MOMENTUM
-            hyb_mom[0] = foo[i++];
-            hyb_mom[1] = foo[i++];
-            hyb_mom[2] = foo[i++];
+                hyb_mom[idir] = sums[i_hyb_mom + idir];
 #endif
-            rho_e      = foo[i++];
-            rho_K      = foo[i++];
-            rho_E      = foo[i++];
+            }
+            rho_e      = sums[i_rho_e];
+            rho_K      = sums[i_rho_K];
+            rho_E      = sums[i_rho_E];
 #ifdef GRAVITY
-            rho_phi    = foo[i++];
+            if (do_rho_phi) {
+                rho_phi = sums[i_rho_phi];
+            }
 
             // Total energy is 1/2 * rho * phi + rho * E for self-gravity,
             // and rho * phi + rho * E for externally-supplied gravity.
-            std::string gravity_type = gravity->get_gravity_type();
-            if (gravity_type == "PoissonGrav" || gravity_type == "MonopoleGrav") {
+            if (gravity_type == "PoissonGrav" || gravity_type == "MonopoleGrav" || gravity_type == "MultipoleGrav") {
                 total_energy = 0.5 * rho_phi + rho_E;
             }
             else {
@@ -271,7 +282,7 @@ Castro::sum_integrated_quantities ()
                 com_vel[idir] = mom[idir] / mass;
             }
 
-            i = 0;
+            int i = 0;
             T_max     = foo_max[i++];
             rho_max   = foo_max[i++];
             ts_te_max = foo_max[i++];    // NOLINT(clang-analyzer-deadcode.DeadStores)
@@ -311,9 +322,9 @@ Castro::sum_integrated_quantities ()
             std::cout << "TIME= " << time << " MAXIMUM T_S / T_E    = " << ts_te_max << '\n';
 #endif
 
-            std::ostream& data_log1 = *Castro::data_logs[0];
+            if (Castro::data_logs[0] && Castro::data_logs[0]->good()) {
 
-            if (data_log1.good()) {
+               std::ostream& data_log1 = *Castro::data_logs[0];
 
                if (time == 0.0) {
 
@@ -423,10 +434,48 @@ Castro::sum_integrated_quantities ()
                data_log1 << std::endl;
 
             }
-        }
-#ifdef BL_LAZY
-        });
+
+            if (Castro::binary_data_logs[0]) {
+
+               BinaryDiagLog& log = *Castro::binary_data_logs[0];
+
+               log.add("TIMESTEP", timestep);
+               log.add("TIME", time);
+               log.add("MASS", mass);
+               log.add("XMOM", mom[0]);
+               log.add("YMOM", mom[1]);
+               log.add("ZMOM", mom[2]);
+               log.add("ANG. MOM. X", ang_mom[0]);
+               log.add("ANG. MOM. Y", ang_mom[1]);
+               log.add("ANG. MOM. Z", ang_mom[2]);
+#ifdef HYBRID_MOMENTUM
+               log.add("HYB. MOM. R", hyb_mom[0]);
+               log.add("HYB. MOM. L", hyb_mom[1]);
+               log.add("HYB. MOM. P", hyb_mom[2]);
 #endif
+               log.add("KIN. ENERGY", rho_K);
+               log.add("INT. ENERGY", rho_e);
+               log.add("GAS ENERGY", rho_E);
+#ifdef GRAVITY
+               log.add("GRAV. ENERGY", rho_phi);
+               log.add("TOTAL ENERGY", total_energy);
+#endif
+               log.add("CENTER OF MASS X-LOC", com[0]);
+               log.add("CENTER OF MASS Y-LOC", com[1]);
+               log.add("CENTER OF MASS Z-LOC", com[2]);
+               log.add("CENTER OF MASS X-VEL", com_vel[0]);
+               log.add("CENTER OF MASS Y-VEL", com_vel[1]);
+               log.add("CENTER OF MASS Z-VEL", com_vel[2]);
+               log.add("MAXIMUM TEMPERATURE", T_max);
+               log.add("MAXIMUM DENSITY", rho_max);
+#ifdef REACTIONS
+               log.add("MAXIMUM T_S / T_E", ts_te_max);
+#endif
+
+               log.end_row();
+
+            }
+        }
     }
 
 #ifdef GRAVITY
@@ -443,38 +492,14 @@ Castro::sum_integrated_quantities ()
         Real h_plus_3  = 0.0;
         Real h_cross_3 = 0.0;
 
-        for (int lev = 0; lev <= finest_level; lev++)
-        {
-            Castro& ca_lev = getLevel(lev);
-
-#if (AMREX_SPACEDIM > 1)
-            // Gravitational wave signal. This is designed to add to these quantities so we can send them directly.
-            ca_lev.gwstrain(time, h_plus_1, h_cross_1, h_plus_2, h_cross_2, h_plus_3, h_cross_3, local_flag);
-#endif
+        // The strain is linear in Qtt, so we can sum Qtt over
+        // levels (done above) before computing the strain.
 
+        if (do_gw && ParallelDescriptor::IOProcessor()) {
+            gwstrain_from_quadrupole(&sums[i_Qtt], h_plus_1, h_cross_1, h_plus_2, h_cross_2, h_plus_3, h_cross_3);
         }
 
-        const int nfoo_sum = 6;
-
-        amrex::Vector<Real> foo_sum(nfoo_sum);
-
-        foo_sum[0] = h_plus_1;
-        foo_sum[1] = h_cross_1;
-        foo_sum[2] = h_plus_2;
-        foo_sum[3] = h_cross_2;
-        foo_sum[4] = h_plus_3;
-        foo_sum[5] = h_cross_3;
-
-        amrex::ParallelDescriptor::ReduceRealSum(foo_sum.dataPtr(), nfoo_sum);
-
-        h_plus_1   = foo_sum[0];
-        h_cross_1  = foo_sum[1];
-        h_plus_2   = foo_sum[2];
-        h_cross_2  = foo_sum[3];
-        h_plus_3   = foo_sum[4];
-        h_cross_3  = foo_sum[5];
-
-        if (ParallelDescriptor::IOProcessor()) {
+        if (ParallelDescriptor::IOProcessor() && Castro::data_logs[1]) {
 
             std::ostream& log = *Castro::data_logs[1];
 
@@ -540,6 +565,23 @@ Castro::sum_integrated_quantities ()
 
         }
 
+        if (ParallelDescriptor::IOProcessor() && Castro::binary_data_logs[1]) {
+
+            BinaryDiagLog& log = *Castro::binary_data_logs[1];
+
+            log.add("TIMESTEP", timestep);
+            log.add("TIME", time);
+            log.add("h_+ (x)", h_plus_1);
+            log.add("h_x (x)", h_cross_1);
+            log.add("h_+ (y)", h_plus_2);
+            log.add("h_x (y)", h_cross_2);
+            log.add("h_+ (z)", h_plus_3);
+            log.add("h_x (z)", h_cross_3);
+
+            log.end_row();
+
+        }
+
     }
 #endif
 
@@ -559,28 +601,11 @@ Castro::sum_integrated_quantities ()
 
         // Integrated mass of all species on the domain
 
-        for (int lev = 0; lev <= finest_level; ++lev) {
-            MultiFab& S_new = getLevel(lev).get_new_data(State_Type);
-            for (int i = 0; i < NumSpec; ++i) {
-                species_mass[i] += getLevel(lev).volWgtSum(S_new, UFS + i, local_flag) / C::M_solar;
-            }
-        }
-
-        int nfoo_sum = NumSpec;
-
-        amrex::Vector<Real> foo_sum(nfoo_sum);
-
         for (int i = 0; i < NumSpec; ++i) {
-            foo_sum[i] = species_mass[i];
+            species_mass[i] = sums[i_species + i] / C::M_solar;
         }
 
-        amrex::ParallelDescriptor::ReduceRealSum(foo_sum.dataPtr(), nfoo_sum);
-
-        for (int i = 0; i < NumSpec; ++i) {
-            species_mass[i] = foo_sum[i];
-        }
-
-        if (ParallelDescriptor::IOProcessor()) {
+        if (ParallelDescriptor::IOProcessor() && Castro::data_logs[2]) {
 
             std::ostream& log = *Castro::data_logs[2];
 
@@ -638,6 +663,21 @@ Castro::sum_integrated_quantities ()
 
         }
 
+        if (ParallelDescriptor::IOProcessor() && Castro::binary_data_logs[2]) {
+
+            BinaryDiagLog& log = *Castro::binary_data_logs[2];
+
+            log.add("TIMESTEP", timestep);
+            log.add("TIME", time);
+
+            for (int i = 0; i < NumSpec; i++) {
+                log.add("Mass " + species_names[i], species_mass[i]);
+            }
+
+            log.end_row();
+
+        }
+
     }
 
     // Information about the AMR driver.
@@ -670,7 +710,7 @@ Castro::sum_integrated_quantities ()
             }
         }
 
-        if (ParallelDescriptor::IOProcessor()) {
+        if (ParallelDescriptor::IOProcessor() && Castro::data_logs[3]) {
 
             std::ostream& log = *Castro::data_logs[3];
 
@@ -744,6 +784,25 @@ Castro::sum_integrated_quantities ()
 
         }
 
+        if (ParallelDescriptor::IOProcessor() && Castro::binary_data_logs[3]) {
+
+            BinaryDiagLog& log = *Castro::binary_data_logs[3];
+
+            log.add("TIMESTEP", timestep);
+            log.add("TIME", time);
+            log.add("DT", dt);
+            log.add("FINEST LEV", parent->finestLevel());
+            log.add("MAX NUMBER OF SUBCYCLES", max_num_subcycles);
+            log.add("COARSE TIMESTEP WALLTIME", wall_time);
+#ifdef AMREX_USE_GPU
+            log.add("MAXIMUM GPU MEMORY USED", gpu_size_used_MB);
+            log.add("MINIMUM GPU MEMORY FREE", gpu_size_free_MB);
+#endif
+
+            log.end_row();
+
+        }
+
     }
 
     problem_diagnostics();
@@ -312,206 +312,369 @@ Castro::locSquaredSum (const std::string& name,
 
 
 #ifdef GRAVITY
+namespace {
+
+    // Contribution of a zone to the second time derivative of the quadrupole
+    // moment tensor, according to the formula in Equation 6.5 of Blanchet,
+    // Damour and Schafer 1990. It involves integrating the mass distribution
+    // and then taking the symmetric trace-free part of the tensor. We can do
+    // the latter operation here since the integral is a linear operator and
+    // each part of the domain contributes independently.
+
+    AMREX_GPU_HOST_DEVICE AMREX_INLINE
+    void quadrupole_tt (int i, int j, int k, const GeometryData& geomdata, Real time,
+                        Array4<Real const> const& U, Array4<Real const> const& grav,
+                        Real dV, Array2D<Real, 0, 2, 0, 2>& dQ)
+    {
+        amrex::ignore_unused(time);
+
+        GpuArray<Real, 3> r;
+        position(i, j, k, geomdata, r);
+
+        for (int n = 0; n < 3; ++n) {
+            r[n] -= problem::center[n];
+        }
+
+        Real rhoInv;
+        if (U(i,j,k,URHO) * dV > 0.0_rt) {
+            rhoInv = 1.0_rt / U(i,j,k,URHO);
+        } else {
+            rhoInv = 0.0_rt;
+        }
+
+        // Account for rotation, if there is any. These will leave
+        // r and vel and changed, if not.
+
+        GpuArray<Real, 3> pos{r};
+#ifdef ROTATION
+        pos = inertial_rotation(r, time);
+#endif
+
+        // For constructing the velocity in the inertial frame, we need to
+        // account for the fact that we have rotated the system already, so that
+        // the r in omega x r is actually the position in the inertial frame, and
+        // not the usual position in the rotating frame. It has to be on physical
+        // grounds, because for binary orbits where the stars aren't moving, that
+        // r never changes, and so the contribution from rotation would never change.
+        // But it must, since the motion vector of the stars changes in the inertial
+        // frame depending on where we are in the orbit.
+
+        GpuArray<Real, 3> vel;
+        vel[0] = U(i,j,k,UMX) * rhoInv;
+        vel[1] = U(i,j,k,UMY) * rhoInv;
+        vel[2] = U(i,j,k,UMZ) * rhoInv;
+
+        GpuArray<Real, 3> inertial_vel{vel};
+#ifdef ROTATION
+        rotational_to_inertial_velocity(i, j, k, geomdata, time, inertial_vel);
+#endif
+
+        GpuArray<Real, 3> g;
+        g[0] = grav(i,j,k,0);
+        g[1] = grav(i,j,k,1);
+        g[2] = grav(i,j,k,2);
+
+        // We need to rotate the gravitational field to be consistent with the rotated position.
+
+        GpuArray<Real, 3> inertial_g{g};
+#ifdef ROTATION
+        inertial_g = inertial_rotation(g, time);
+#endif
+
+        // Absorb the factor of 2 outside the integral into the zone mass, for efficiency.
+
+        Real dM = 2.0_rt * U(i,j,k,URHO) * dV;
+
+        Array2D<Real, 0, 2, 0, 2> dQtt{0.0};
+
+        if (AMREX_SPACEDIM == 3) {
+
+            for (int m = 0; m < 3; ++m) {
+                for (int l = 0; l < 3; ++l) {
+                    dQtt(l,m) += dM * (inertial_vel[l] * inertial_vel[m] + pos[l] * inertial_g[m]);
+                }
+            }
+
+        } else {
+
+            // For axisymmetric coordinates we need to be careful here.
+            // We want to calculate the quadrupole tensor in terms of
+            // Cartesian coordinates but our coordinates are cylindrical (R, z).
+            // What we can do is to first express the Cartesian coordinates
+            // as (x, y, z) = (R cos(phi), R sin(phi), z). Then we can integrate
+            // out the phi coordinate for each component. The off-diagonal components
+            // all then vanish automatically. The on-diagonal components xx and yy
+            // pick up a factor of cos**2(phi) which when integrated from (0, 2*pi)
+            // yields pi. Note that we're going to choose that the cylindrical z axis
+            // coincides with the Cartesian x-axis, which is our default choice.
+
+            // We also need to then divide by the volume by 2*pi since
+            // it has already been integrated out.
+
+            dM /= (2.0_rt * M_PI);
+
+            dQtt(0,0) += dM * (2.0_rt * M_PI) * (inertial_vel[1] * inertial_vel[1] + pos[1] * inertial_g[1]);
+            dQtt(1,1) += dM * M_PI * (inertial_vel[0] * inertial_vel[0] + pos[0] * g[0]);
+            dQtt(2,2) += dM * M_PI * (inertial_vel[0] * inertial_vel[0] + pos[0] * g[0]);
+
+        }
+
+        // Now take the symmetric trace-free part of the quadrupole moment.
+        // The operator is defined in Equation 6.7 of Blanchet et al. (1990):
+        // STF(A^{ij}) = 1/2 A^{ij} + 1/2 A^{ji} - 1/3 delta^{ij} sum_{k} A^{kk}.
+
+        for (int l = 0; l < 3; ++l) {
+            for (int m = 0; m < 3; ++m) {
+                dQ(l,m) = 0.5_rt * dQtt(l,m) + 0.5_rt * dQtt(m,l);
+                if (l == m) {
+                    dQ(l,m) -= (1.0_rt / 3.0_rt) * dQtt(m,m);
+                }
+            }
+        }
+    }
+
+}
+#endif
+
 void
-Castro::gwstrain (Real time,
-                  Real& h_plus_1, Real& h_cross_1,
-                  Real& h_plus_2, Real& h_cross_2,
-                  Real& h_plus_3, Real& h_cross_3,
-                  bool local) {
+Castro::volWgtSums (const Vector<sum_quantity>& quantities, Real* sums, Real time)
+{
+    BL_PROFILE("Castro::volWgtSums()");
 
     amrex::ignore_unused(time);
 
-    BL_PROFILE("Castro::gwstrain()");
+    const int nq = static_cast<int>(quantities.size());
 
-    // We have nothing to do if the user did not request the gravitational wave
-    // strain (inferred from whether the observation distance is positive).
-    if (castro::gw_dist <= 0.0_rt) {
+    if (nq == 0) {
         return;
     }
 
-    GeometryData geomdata = geom.data();
-
-    MultiFab& S_new = get_new_data(State_Type);
-    MultiFab& grav_new = get_new_data(Gravity_Type);
-
     bool mask_available = level < parent->finestLevel();
 
     MultiFab tmp_mf;
     const MultiFab& mask_mf = mask_available ? getLevel(level+1).build_fine_mask() : tmp_mf;
 
-    // Qtt stores the second time derivative of the quadrupole moment.
-    // We calculate it directly rather than computing the quadrupole moment
-    // and differentiating it in time, because the latter method is less accurate
-    // and requires the state at other timesteps. See, e.g., Equation 5 of
-    // Loren-Aguilar et al. 2005.
+    const MultiFab& S_new = get_new_data(State_Type);
+#ifdef GRAVITY
+    const MultiFab& phi_new = get_new_data(PhiGrav_Type);
+    const MultiFab& grav_new = get_new_data(Gravity_Type);
+#endif
 
-    ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum,
-              ReduceOpSum, ReduceOpSum, ReduceOpSum,
-              ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_op;
-    ReduceData<Real, Real, Real,
-               Real, Real, Real,
-               Real, Real, Real> reduce_data(reduce_op);
-    using ReduceTuple = typename decltype(reduce_data)::Type;
+#ifdef GRAVITY
+    GeometryData geomdata = geom.data();
+#endif
+
+    auto dx     = geom.CellSizeArray();
+    auto problo = geom.ProbLoArray();
+
+    Gpu::DeviceVector<sum_quantity> quantities_d(nq);
+    Gpu::copyAsync(Gpu::hostToDevice, quantities.begin(), quantities.end(), quantities_d.begin());
+    const sum_quantity* qty = quantities_d.data();
+
+    // Each quantity is reduced in place into its own slot of the sums
+    // array. On the CPU, each thread gets its own copy of the array,
+    // which we add up at the end.
+
+#ifdef AMREX_USE_GPU
+    Gpu::DeviceVector<Real> priv_sums(nq, 0.0_rt);
+#else
+    const int nthreads = OpenMP::get_max_threads();
+    Vector<Real> priv_sums(nthreads * nq, 0.0_rt);
+#endif
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel
 #endif
-    for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    {
+#ifdef AMREX_USE_GPU
+        Real* sums_ptr = priv_sums.data();
+#else
+        Real* sums_ptr = priv_sums.data() + OpenMP::get_thread_num() * nq;
+#endif
 
-        const Box& box = mfi.tilebox();
+        for (MFIter mfi(S_new, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& box = mfi.tilebox();
 
-        auto rho = S_new[mfi].array(URHO);
-        auto vol = volume.array(mfi);
-        auto xmom = S_new[mfi].array(UMX);
-        auto ymom = S_new[mfi].array(UMY);
-        auto zmom = S_new[mfi].array(UMZ);
-        auto gravx = grav_new[mfi].array(0);
-        auto gravy = grav_new[mfi].array(1);
-        auto gravz = grav_new[mfi].array(2);
-        auto const& mask = mask_available ? mask_mf.array(mfi) : Array4<Real>{};
+            auto const& U = S_new.const_array(mfi);
+#ifdef GRAVITY
+            auto const& phi = phi_new.const_array(mfi);
+            auto const& grav = grav_new.const_array(mfi);
+#endif
+            auto const& vol = volume.const_array(mfi);
+            auto const& mask = mask_available ? mask_mf.const_array(mfi) : Array4<Real const>{};
 
-        // Calculate the second time derivative of the quadrupole moment tensor,
-        // according to the formula in Equation 6.5 of Blanchet, Damour and Schafer 1990.
-        // It involves integrating the mass distribution and then taking the symmetric
-        // trace-free part of the tensor. We can do the latter operation here since the
-        // integral is a linear operator and each part of the domain contributes independently.
+            amrex::ParallelFor(Gpu::KernelInfo().setReduction(true), box,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, Gpu::Handler const& handler) noexcept
+            {
+                Real maskFactor = mask_available ? mask(i,j,k) : 1.0_rt;
 
-        reduce_op.eval(box, reduce_data,
-        [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k) -> ReduceTuple
-        {
-            Real maskFactor = mask_available ? mask(i,j,k) : 1.0_rt;
+                Real dV = vol(i,j,k) * maskFactor;
 
-            GpuArray<Real, 3> r;
-            position(i, j, k, geomdata, r);
+                Real loc[3];
 
-            for (int n = 0; n < 3; ++n) {
-                r[n] -= problem::center[n];
-            }
+                loc[0] = problo[0] + (0.5_rt + i) * dx[0];
 
-            Real rhoInv;
-            if (rho(i,j,k) * maskFactor > 0.0_rt) {
-                rhoInv = 1.0_rt / rho(i,j,k);
-            } else {
-                rhoInv = 0.0_rt;
-            }
-
-            // Account for rotation, if there is any. These will leave
-            // r and vel and changed, if not.
+#if AMREX_SPACEDIM >= 2
+                loc[1] = problo[1] + (0.5_rt + j) * dx[1];
+#else
+                loc[1] = 0.0_rt;
+#endif
 
-            GpuArray<Real, 3> pos{r};
-#ifdef ROTATION
-            pos = inertial_rotation(r, time);
+#if AMREX_SPACEDIM == 3
+                loc[2] = problo[2] + (0.5_rt + k) * dx[2];
+#else
+                loc[2] = 0.0_rt;
 #endif
 
-            // For constructing the velocity in the inertial frame, we need to
-            // account for the fact that we have rotated the system already, so that
-            // the r in omega x r is actually the position in the inertial frame, and
-            // not the usual position in the rotating frame. It has to be on physical
-            // grounds, because for binary orbits where the stars aren't moving, that
-            // r never changes, and so the contribution from rotation would never change.
-            // But it must, since the motion vector of the stars changes in the inertial
-            // frame depending on where we are in the orbit.
-
-            GpuArray<Real, 3> vel;
-            vel[0] = xmom(i,j,k) * maskFactor * rhoInv;
-            vel[1] = ymom(i,j,k) * maskFactor * rhoInv;
-            vel[2] = zmom(i,j,k) * maskFactor * rhoInv;
-
-            GpuArray<Real, 3> inertial_vel{vel};
-#ifdef ROTATION
-            rotational_to_inertial_velocity(i, j, k, geomdata, time, inertial_vel);
+#ifdef GRAVITY
+                // The quadrupole tensor is only computed once per zone,
+                // the first time one of its components is requested.
+
+                Array2D<Real, 0, 2, 0, 2> dQ;
+                bool have_dQ = false;
 #endif
 
-            GpuArray<Real, 3> g;
-            g[0] = gravx(i,j,k) * maskFactor;
-            g[1] = gravy(i,j,k) * maskFactor;
-            g[2] = gravz(i,j,k) * maskFactor;
+                for (int n = 0; n < nq; ++n) {
 
-            // We need to rotate the gravitational field to be consistent with the rotated position.
+                    const int comp = qty[n].comp;
+                    const int dir = qty[n].dir;
 
-            GpuArray<Real, 3> inertial_g{g};
-#ifdef ROTATION
-            inertial_g = inertial_rotation(g, time);
-#endif
+                    Real ds = 0.0_rt;
+
+                    switch (qty[n].type) {
 
-            // Absorb the factor of 2 outside the integral into the zone mass, for efficiency.
+                    case sum_quantity::StateComp:
 
-            Real dM = 2.0_rt * rho(i,j,k) * vol(i,j,k) * maskFactor;
+                        ds = U(i,j,k,comp) * dV;
+                        break;
 
-            Array2D<Real, 0, 2, 0, 2> dQtt{0.0};
+                    case sum_quantity::LocWgt:
 
-            if (AMREX_SPACEDIM == 3) {
+                        ds = U(i,j,k,comp) * dV * loc[dir];
+                        break;
 
-                for (int m = 0; m < 3; ++m) {
-                    for (int l = 0; l < 3; ++l) {
-                        dQtt(l,m) += dM * (inertial_vel[l] * inertial_vel[m] + pos[l] * inertial_g[m]);
+                    case sum_quantity::AngMom:
+                    {
+                        Real r[3];
+                        for (int d = 0; d < 3; ++d) {
+                            r[d] = loc[d];
+                        }
+                        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                            r[d] -= problem::center[d];
+                        }
+
+                        if (dir == 0) {
+                            ds = r[1] * U(i,j,k,UMZ) - r[2] * U(i,j,k,UMY);
+                        }
+                        else if (dir == 1) {
+                            ds = r[2] * U(i,j,k,UMX) - r[0] * U(i,j,k,UMZ);
+                        }
+                        else {
+                            ds = r[0] * U(i,j,k,UMY) - r[1] * U(i,j,k,UMX);
+                        }
+                        ds *= dV;
+                        break;
                     }
-                }
 
-            } else {
+                    case sum_quantity::KinEng:
 
-                // For axisymmetric coordinates we need to be careful here.
-                // We want to calculate the quadrupole tensor in terms of
-                // Cartesian coordinates but our coordinates are cylindrical (R, z).
-                // What we can do is to first express the Cartesian coordinates
-                // as (x, y, z) = (R cos(phi), R sin(phi), z). Then we can integrate
-                // out the phi coordinate for each component. The off-diagonal components
-                // all then vanish automatically. The on-diagonal components xx and yy
-                // pick up a factor of cos**2(phi) which when integrated from (0, 2*pi)
-                // yields pi. Note that we're going to choose that the cylindrical z axis
-                // coincides with the Cartesian x-axis, which is our default choice.
+                        ds = 0.5_rt / U(i,j,k,URHO) * (U(i,j,k,UMX) * U(i,j,k,UMX) +
+                                                       U(i,j,k,UMY) * U(i,j,k,UMY) +
+                                                       U(i,j,k,UMZ) * U(i,j,k,UMZ)) * dV;
+                        break;
 
-                // We also need to then divide by the volume by 2*pi since
-                // it has already been integrated out.
+#ifdef GRAVITY
+                    case sum_quantity::PhiProduct:
 
-                dM /= (2.0_rt * M_PI);
+                        ds = U(i,j,k,comp) * phi(i,j,k) * dV;
+                        break;
 
-                dQtt(0,0) += dM * (2.0_rt * M_PI) * (inertial_vel[1] * inertial_vel[1] + pos[1] * inertial_g[1]);
-                dQtt(1,1) += dM * M_PI * (inertial_vel[0] * inertial_vel[0] + pos[0] * g[0]);
-                dQtt(2,2) += dM * M_PI * (inertial_vel[0] * inertial_vel[0] + pos[0] * g[0]);
+                    case sum_quantity::Quadrupole:
 
-            }
+                        if (!have_dQ) {
+                            quadrupole_tt(i, j, k, geomdata, time, U, grav, dV, dQ);
+                            have_dQ = true;
+                        }
+                        ds = dQ(dir % 3, dir / 3);
+                        break;
+#endif
 
-            // Now take the symmetric trace-free part of the quadrupole moment.
-            // The operator is defined in Equation 6.7 of Blanchet et al. (1990):
-            // STF(A^{ij}) = 1/2 A^{ij} + 1/2 A^{ji} - 1/3 delta^{ij} sum_{k} A^{kk}.
+                    default:
 
-            Array2D<Real, 0, 2, 0, 2> dQ;
+                        break;
 
-            for (int l = 0; l < 3; ++l) {
-                for (int m = 0; m < 3; ++m) {
-                    dQ(l,m) = 0.5_rt * dQtt(l,m) + 0.5_rt * dQtt(m,l);
-                    if (l == m) {
-                        dQ(l,m) -= (1.0_rt / 3.0_rt) * dQtt(m,m);
                     }
+
+                    Gpu::deviceReduceSum(&sums_ptr[n], ds, handler);
                 }
-            }
+            });
+        }
+    }
 
-            return {dQ(0,0), dQ(1,0), dQ(2,0),
-                    dQ(0,1), dQ(1,1), dQ(2,1),
-                    dQ(0,2), dQ(1,2), dQ(2,2)};
-        });
+#ifdef AMREX_USE_GPU
+    Vector<Real> level_sums(nq);
+    Gpu::copyAsync(Gpu::deviceToHost, priv_sums.begin(), priv_sums.end(), level_sums.begin());
+    Gpu::streamSynchronize();
+
+    for (int n = 0; n < nq; ++n) {
+        sums[n] += level_sums[n];
+    }
+#else
+    for (int t = 0; t < nthreads; ++t) {
+        for (int n = 0; n < nq; ++n) {
+            sums[n] += priv_sums[t * nq + n];
+        }
     }
+#endif
+}
+
+#ifdef GRAVITY
+void
+Castro::gwstrain (Real time,
+                  Real& h_plus_1, Real& h_cross_1,
+                  Real& h_plus_2, Real& h_cross_2,
+                  Real& h_plus_3, Real& h_cross_3,
+                  bool local) {
 
-    Array2D<Real, 0, 2, 0, 2> Qtt;
+    BL_PROFILE("Castro::gwstrain()");
 
-    ReduceTuple hv = reduce_data.value();
-    Qtt(0,0) = amrex::get<0>(hv);
-    Qtt(1,0) = amrex::get<1>(hv);
-    Qtt(2,0) = amrex::get<2>(hv);
-    Qtt(0,1) = amrex::get<3>(hv);
-    Qtt(1,1) = amrex::get<4>(hv);
-    Qtt(2,1) = amrex::get<5>(hv);
-    Qtt(0,2) = amrex::get<6>(hv);
-    Qtt(1,2) = amrex::get<7>(hv);
-    Qtt(2,2) = amrex::get<8>(hv);
+    // We have nothing to do if the user did not request the gravitational wave
+    // strain (inferred from whether the observation distance is positive).
+    if (castro::gw_dist <= 0.0_rt) {
+        return;
+    }
+
+    // Qtt stores the second time derivative of the quadrupole moment.
+    // We calculate it directly rather than computing the quadrupole moment
+    // and differentiating it in time, because the latter method is less accurate
+    // and requires the state at other timesteps. See, e.g., Equation 5 of
+    // Loren-Aguilar et al. 2005.
+
+    Vector<sum_quantity> quantities;
+    for (int n = 0; n < 9; ++n) {
+        quantities.push_back({sum_quantity::Quadrupole, 0, n});
+    }
+
+    Real Qtt[9] = {0.0};
+
+    volWgtSums(quantities, Qtt, time);
 
     // Now, do a global reduce over all processes.
 
     if (!local) {
-        amrex::ParallelDescriptor::ReduceRealSum(Qtt.begin(), 9);
+        amrex::ParallelDescriptor::ReduceRealSum(Qtt, 9);
     }
 
+    gwstrain_from_quadrupole(Qtt, h_plus_1, h_cross_1, h_plus_2, h_cross_2, h_plus_3, h_cross_3);
+}
+
+void
+Castro::gwstrain_from_quadrupole (const Real* Qtt,
+                                  Real& h_plus_1, Real& h_cross_1,
+                                  Real& h_plus_2, Real& h_cross_2,
+                                  Real& h_plus_3, Real& h_cross_3)
+{
     // Now that we have the second time derivative of the quadrupole
     // tensor, we can calculate the transverse-trace gauge strain tensor.
 
@@ -560,7 +723,7 @@ Castro::gwstrain (Real time,
             for (int k = 0; k < 3; ++k) {
                 for (int j = 0; j < 3; ++j) {
                     for (int i = 0; i < 3; ++i) {
-                        h[j][i] += proj[l][k][j][i] * Qtt(k, l);
+                        h[j][i] += proj[l][k][j][i] * Qtt[k + 3 * l];
                     }
                 }
             }
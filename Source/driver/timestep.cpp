@@ -40,6 +40,13 @@ Castro::estdt_cfl (int is_new)
 
   auto const& ua = stateMF.const_arrays();
 
+  // If the new-time sound speed is in the EOS cache we can use it
+  // directly; otherwise we need to call the EOS here.
+
+  const bool use_eos_cache = is_new && eos_cache_is_current(state[State_Type].curTime());
+
+  auto const& ca = use_eos_cache ? eos_cache.const_arrays() : ua;
+
   auto r = amrex::ParReduce(TypeList<ReduceOpMin>{}, TypeList<ValLocPair<Real, IntVect>>{}, stateMF,
   [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) -> GpuTuple<ValLocPair<Real, IntVect>>
   {
@@ -50,20 +57,28 @@ Castro::estdt_cfl (int is_new)
 
       Real rhoInv = 1.0_rt / u(i,j,k,URHO);
 
-      eos_rep_t eos_state;
-      eos_state.rho = u(i,j,k,URHO);
-      eos_state.T = u(i,j,k,UTEMP);
-      eos_state.e = u(i,j,k,UEINT) * rhoInv;
-      for (int n = 0; n < NumSpec; n++) {
-          eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
-      }
+      Real c;
+
+      if (use_eos_cache) {
+          c = ca[box_no](i,j,k,ECACHE_CS);
+      } else {
+          eos_rep_t eos_state;
+          eos_state.rho = u(i,j,k,URHO);
+          eos_state.T = u(i,j,k,UTEMP);
+          eos_state.e = u(i,j,k,UEINT) * rhoInv;
+          for (int n = 0; n < NumSpec; n++) {
+              eos_state.xn[n] = u(i,j,k,UFS+n) * rhoInv;
+          }
 #if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-          eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
-      }
+          for (int n = 0; n < NumAux; n++) {
+              eos_state.aux[n] = u(i,j,k,UFX+n) * rhoInv;
+          }
 #endif
 
-      eos(eos_input_re, eos_state);
+          eos(eos_input_re, eos_state);
+
+          c = eos_state.cs;
+      }
 
       // Compute velocity and then calculate CFL timestep.
 
@@ -75,8 +90,6 @@ Castro::estdt_cfl (int is_new)
       Real uz = u(i,j,k,UMZ) * rhoInv;
 #endif
 
-      Real c = eos_state.cs;
-
       Real dt1 = dx[0]/(c + std::abs(ux));
 
       Real dt2;
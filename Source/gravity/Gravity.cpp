@@ -96,6 +96,9 @@ Gravity::Gravity(Amr* Parent, int _finest_level, BCRec* _phys_bc, int _density)
          make_mg_bc();
          init_multipole_grav();
      }
+     else if (gravity::gravity_type == "MultipoleGrav") {
+         init_multipole_grav();
+     }
      max_rhs = 0.0;
      numpts_at_level = -1;
 }
@@ -115,10 +118,11 @@ Gravity::read_params ()
 
         if ( (gravity::gravity_type != "ConstantGrav") &&
              (gravity::gravity_type != "PoissonGrav") &&
-             (gravity::gravity_type != "MonopoleGrav") )
+             (gravity::gravity_type != "MonopoleGrav") &&
+             (gravity::gravity_type != "MultipoleGrav") )
              {
                 std::cout << "Sorry -- dont know this gravity type"  << std::endl;
-                amrex::Abort("Options are ConstantGrav, PoissonGrav, or MonopoleGrav");
+                amrex::Abort("Options are ConstantGrav, PoissonGrav, MonopoleGrav, or MultipoleGrav");
              }
 
         if (  gravity::gravity_type == "ConstantGrav")
@@ -149,6 +153,18 @@ Gravity::read_params ()
         }
 #endif
 
+#if (AMREX_SPACEDIM < 3)
+        if (gravity::gravity_type == "MultipoleGrav")
+        {
+          amrex::Abort(" gravity::gravity_type = MultipoleGrav is only supported in 3D");
+        }
+#else
+        if (gravity::gravity_type == "MultipoleGrav" && dgeom.isAllPeriodic())
+        {
+          amrex::Abort(" gravity::gravity_type = MultipoleGrav doesn't make sense with periodic boundaries");
+        }
+#endif
+
         if (pp.contains("get_g_from_phi") && !gravity::get_g_from_phi && gravity::gravity_type == "PoissonGrav") {
             amrex::Print() << "Warning: gravity::gravity_type = PoissonGrav assumes get_g_from_phi is true" << std::endl;
         }
@@ -898,6 +914,14 @@ Gravity::get_old_grav_vector(int level, MultiFab& grav_vector, Real time)
        make_radial_gravity(level,prev_time,radial_grav_old[level]);
        interpolate_monopole_grav(level,radial_grav_old[level],grav);
 
+#if (AMREX_SPACEDIM == 3)
+    } else if (gravity::gravity_type == "MultipoleGrav") {
+
+       const Real prev_time = LevelData[level]->get_state_data(State_Type).prevTime();
+       MultiFab& phi = LevelData[level]->get_old_data(PhiGrav_Type);
+       make_multipole_gravity(level,prev_time,phi,grav);
+#endif
+
     } else if (gravity::gravity_type == "PoissonGrav") {
 
        const Geometry& geom = parent->Geom(level);
@@ -970,6 +994,14 @@ Gravity::get_new_grav_vector(int level, MultiFab& grav_vector, Real time)
         make_radial_gravity(level,cur_time,radial_grav_new[level]);
         interpolate_monopole_grav(level,radial_grav_new[level],grav);
 
+#if (AMREX_SPACEDIM == 3)
+    } else if (gravity::gravity_type == "MultipoleGrav") {
+
+        const Real cur_time = LevelData[level]->get_state_data(State_Type).curTime();
+        MultiFab& phi = LevelData[level]->get_new_data(PhiGrav_Type);
+        make_multipole_gravity(level,cur_time,phi,grav);
+#endif
+
     } else if (gravity::gravity_type == "PoissonGrav") {
 
         const Geometry& geom = parent->Geom(level);
@@ -2336,10 +2368,366 @@ Gravity::fill_multipole_BCs(int crse_level, int fine_level, const Vector<MultiFa
 
 }
 
+#if (AMREX_SPACEDIM == 3)
+void
+Gravity::make_multipole_gravity(int level, Real time, MultiFab& phi, MultiFab& grav_vector)
+{
+    BL_PROFILE("Gravity::make_multipole_gravity()");
+
+    BL_ASSERT(gravity::lnum >= 0);
+
+    const Real strt = ParallelDescriptor::second();
+
+    // We bin the mass into radial shells with the same width as the
+    // MonopoleGrav bins (the coarse zone width divided by drdxfac).
+    // Each zone only adds to the moments of its own shell, and the
+    // moments interior and exterior to every shell are then obtained
+    // by prefix sums over the shells. This keeps the cost of constructing
+    // the moments independent of the number of shells.
+
+    const int nshells = gravity::drdxfac * numpts_at_level;
+
+    const Real drInv = multipole::rmax * static_cast<Real>(gravity::drdxfac) / parent->Geom(0).CellSize(0);
+
+    const int nq = multipole::nmoments;
+
+    Box boxq( IntVect(0, 0, 0), IntVect(gravity::lnum, gravity::lnum, nshells-1) );
+
+    // qShell holds the moments of the mass in each shell. qSum holds, for
+    // each shell, the interior moments summed over all shells inside it
+    // and the exterior moments summed over all shells outside it.
+
+    FArrayBox qShell(boxq, nq);
+    FArrayBox qSum(boxq, nq);
+
+    qShell.setVal<RunOn::Device>(0.0);
+
+    for (int lev = 0; lev <= level; ++lev) {
+
+        // Get the density at this time, masked by any finer level
+        // that we are also including.
+
+        MultiFab source(grids[lev], dmap[lev], 1, 0);
+
+        AmrLevel::FillPatch(*LevelData[lev], source, 0, time, State_Type, URHO, 1);
+
+        if (lev < level) {
+            auto *castro_level = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)));
+            if (castro_level != nullptr) {
+                const MultiFab& mask = castro_level->build_fine_mask();
+                MultiFab::Multiply(source, mask, 0, 0, 1, 0);
+            } else {
+                amrex::Abort("unable to access mask");
+            }
+        }
+
+        const auto dx = parent->Geom(lev).CellSizeArray();
+        const auto problo = parent->Geom(lev).ProbLoArray();
+
+#ifdef _OPENMP
+        int nthreads = omp_get_max_threads();
+        Vector<std::unique_ptr<FArrayBox> > priv_q(nthreads);
+        for (int i=0; i<nthreads; i++) {
+            priv_q[i] = std::make_unique<FArrayBox>(boxq, nq);
+        }
+#pragma omp parallel
+#endif
+        {
+#ifdef _OPENMP
+            int tid = omp_get_thread_num();
+            priv_q[tid]->setVal<RunOn::Device>(0.0);
+            auto q_arr = priv_q[tid]->array();
+#else
+            auto q_arr = qShell.array();
+#endif
+
+            for (MFIter mfi(source, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.tilebox();
+
+                auto rho = source[mfi].array();
+                auto vol = (*volume[lev])[mfi].array();
+
+                amrex::ParallelFor(bx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    // Skip the zones that are covered by a finer level.
+
+                    if (rho(i,j,k) == 0.0_rt) {
+                        return;
+                    }
+
+                    Real rmax_cubed_inv = 1.0_rt / (multipole::rmax * multipole::rmax * multipole::rmax);
+
+                    Real x = (problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0]) / multipole::rmax;
+                    Real y = (problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1]) / multipole::rmax;
+                    Real z = (problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2]) / multipole::rmax;
+
+                    Real r = std::sqrt(x * x + y * y + z * z);
+
+                    Real cosTheta = 1.0_rt;
+                    if (r > 0.0_rt) {
+                        cosTheta = z / r;
+                    }
+                    Real phiAngle = std::atan2(y, x);
+
+                    int index = amrex::min(static_cast<int>(r * drInv), nshells-1);
+
+                    Real dm = rho(i,j,k);
+                    Real dV = vol(i,j,k) * rmax_cubed_inv;
+
+                    multipole_add_shell(cosTheta, phiAngle, r, dm, dV, q_arr, index, true);
+
+                    // Now add in contributions if we have any symmetric boundaries.
+                    // The image zones generally fall in a different shell.
+
+                    if (multipole::doSymmetricAdd) {
+
+                        multipole_symmetric_images(x, y, z, problo,
+                        [&] (Real cosThetaImage, Real phiAngleImage, Real rImage)
+                        {
+                            int indexImage = amrex::min(static_cast<int>(rImage * drInv), nshells-1);
+
+                            multipole_add_shell(cosThetaImage, phiAngleImage, rImage, dm, dV, q_arr, indexImage);
+                        });
+
+                    }
+                });
+            }
+
+#ifdef _OPENMP
+            int np = static_cast<int>(boxq.numPts()) * nq;
+            Real* pq = qShell.dataPtr();
+#pragma omp barrier
+#pragma omp for
+            for (int i=0; i<np; ++i)
+            {
+                for (int it=0; it<nthreads; it++) {
+                    const Real* pp = priv_q[it]->dataPtr();
+                    pq[i] += pp[i];
+                }
+            }
+#endif
+
+        } // end OpenMP parallel loop
+
+    } // end loop over levels
+
+    // Now, do a global reduce over all processes. All of the moments
+    // are stored contiguously, so this is a single reduction.
+
+    Real* q_ptr = qShell.dataPtr();
+
+    FArrayBox qShell_host(The_Pinned_Arena());
+
+    if (!ParallelDescriptor::UseGpuAwareMpi()) {
+        if (The_Arena() == The_Managed_Arena()) {
+            qShell.prefetchToHost();
+        }
+        else if (The_Arena() == The_Device_Arena()) {
+            qShell_host.resize(boxq, nq);
+            qShell_host.copy<RunOn::Device>(qShell, boxq, 0, boxq, 0, nq);
+            q_ptr = qShell_host.dataPtr();
+        }
+    }
+
+    Gpu::synchronize();
+
+    ParallelDescriptor::ReduceRealSum(q_ptr, static_cast<int>(boxq.numPts()) * nq);
+
+    if (!ParallelDescriptor::UseGpuAwareMpi()) {
+        if (The_Arena() == The_Managed_Arena()) {
+            qShell.prefetchToDevice();
+        }
+        else if (The_Arena() == The_Device_Arena()) {
+            qShell.copy<RunOn::Device>(qShell_host, boxq, 0, boxq, 0, nq);
+        }
+    }
+
+    // Prefix sums over the shells: the interior moments accumulate from
+    // the center outward, and the exterior moments from the outside inward.
+    // A shell's own moments are not included here; they are interpolated
+    // in when evaluating the potential in a zone inside that shell.
+
+    {
+        auto qs = qShell.const_array();
+        auto qc = qSum.array();
+
+        Box boxlm( IntVect(0, 0, 0), IntVect(gravity::lnum, gravity::lnum, 0) );
+
+        amrex::ParallelFor(boxlm,
+        [=] AMREX_GPU_DEVICE (int l, int m, int) noexcept
+        {
+            if (m > l) {
+                return;
+            }
+
+            for (int c = multipole::iL0; c <= multipole::iLS; ++c) {
+                Real sum = 0.0_rt;
+                for (int n = 0; n < nshells; ++n) {
+                    qc(l,m,n,c) = sum;
+                    sum += qs(l,m,n,c);
+                }
+            }
+
+            for (int c = multipole::iU0; c <= multipole::iUS; ++c) {
+                Real sum = 0.0_rt;
+                for (int n = nshells-1; n >= 0; --n) {
+                    qc(l,m,n,c) = sum;
+                    sum += qs(l,m,n,c);
+                }
+            }
+        });
+    }
+
+    // Finally, evaluate the potential in every zone on this level (and
+    // one zone beyond the tile, so that we can difference it to get the
+    // gravitational acceleration).
+
+    const auto dx = parent->Geom(level).CellSizeArray();
+    const auto problo = parent->Geom(level).ProbLoArray();
+
+    auto qs = qShell.const_array();
+    auto qc = qSum.const_array();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        FArrayBox phi_fab;
+
+        for (MFIter mfi(grav_vector, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            const Box& pbx = amrex::grow(bx, 1);
+
+            phi_fab.resize(pbx, 1);
+            Elixir elix_phi = phi_fab.elixir();
+
+            auto phi_tmp = phi_fab.array();
+
+            amrex::ParallelFor(pbx,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                Real rmax_cubed = multipole::rmax * multipole::rmax * multipole::rmax;
+
+                Real x = (problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0]) / multipole::rmax;
+                Real y = (problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1]) / multipole::rmax;
+                Real z = (problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2]) / multipole::rmax;
+
+                Real r = std::sqrt(x * x + y * y + z * z);
+
+                Real rInv = 0.0_rt;
+                Real cosTheta = 1.0_rt;
+                if (r > 0.0_rt) {
+                    rInv = 1.0_rt / r;
+                    cosTheta = z / r;
+                }
+                Real phiAngle = std::atan2(y, x);
+
+                // Locate the zone within its shell. The fraction of the
+                // shell's own mass that is treated as interior to the zone
+                // is the fraction of the shell's width inside the zone's radius.
+
+                Real rs = r * drInv;
+                int n = amrex::min(static_cast<int>(rs), nshells-1);
+                Real f = amrex::Clamp(rs - static_cast<Real>(n), 0.0_rt, 1.0_rt);
+
+                Real legPolyL, legPolyL1, legPolyL2;
+                Real assocLegPolyLM, assocLegPolyLM1, assocLegPolyLM2;
+
+                Real phi_sum = 0.0_rt;
+
+                Real r_L = 1.0_rt;
+                Real r_U = rInv;
+
+                for (int l = 0; l <= gravity::lnum; ++l) {
+
+                    calcLegPolyL(l, legPolyL, legPolyL1, legPolyL2, cosTheta);
+
+                    Real qL = qc(l,0,n,multipole::iL0) + f * qs(l,0,n,multipole::iL0);
+                    Real qU = qc(l,0,n,multipole::iU0) + (1.0_rt - f) * qs(l,0,n,multipole::iU0);
+
+                    phi_sum += (qL * r_U + qU * r_L) * legPolyL;
+
+                    r_L *= r;
+                    r_U *= rInv;
+
+                }
+
+                for (int m = 1; m <= gravity::lnum; ++m) {
+
+                    Real cosM = std::cos(m * phiAngle);
+                    Real sinM = std::sin(m * phiAngle);
+
+                    r_L = std::pow(r, m);
+                    r_U = std::pow(rInv, m + 1);
+
+                    for (int l = m; l <= gravity::lnum; ++l) {
+
+                        calcAssocLegPolyLM(l, m, assocLegPolyLM, assocLegPolyLM1, assocLegPolyLM2, cosTheta);
+
+                        Real qLC = qc(l,m,n,multipole::iLC) + f * qs(l,m,n,multipole::iLC);
+                        Real qLS = qc(l,m,n,multipole::iLS) + f * qs(l,m,n,multipole::iLS);
+                        Real qUC = qc(l,m,n,multipole::iUC) + (1.0_rt - f) * qs(l,m,n,multipole::iUC);
+                        Real qUS = qc(l,m,n,multipole::iUS) + (1.0_rt - f) * qs(l,m,n,multipole::iUS);
+
+                        phi_sum += ((qLC * r_U + qUC * r_L) * cosM + (qLS * r_U + qUS * r_L) * sinM) * assocLegPolyLM;
+
+                        r_L *= r;
+                        r_U *= rInv;
+
+                    }
+                }
+
+                // Make sure we undo the volume scaling here.
+
+                phi_tmp(i,j,k) = -C::Gconst * phi_sum * rmax_cubed / multipole::rmax;
+            });
+
+            auto phi_arr = phi[mfi].array();
+            auto grav = grav_vector[mfi].array();
+
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                phi_arr(i,j,k) = phi_tmp(i,j,k);
+
+                // g = - grad(phi)
+
+                grav(i,j,k,0) = -(phi_tmp(i+1,j,k) - phi_tmp(i-1,j,k)) / (2.0_rt * dx[0]);
+                grav(i,j,k,1) = -(phi_tmp(i,j+1,k) - phi_tmp(i,j-1,k)) / (2.0_rt * dx[1]);
+                grav(i,j,k,2) = -(phi_tmp(i,j,k+1) - phi_tmp(i,j,k-1)) / (2.0_rt * dx[2]);
+            });
+        }
+    }
+
+    if (gravity::verbose)
+    {
+        const int IOProc = ParallelDescriptor::IOProcessorNumber();
+        Real      end    = ParallelDescriptor::second() - strt;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(end,IOProc);
+        amrex::Print() << "Gravity::make_multipole_gravity() time = " << end << std::endl << std::endl;
+#ifdef BL_LAZY
+        });
+#endif
+    }
+}
+#endif
+
 #if (AMREX_SPACEDIM == 3)
 void
 Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
 {
+    if (gravity::direct_sum_bcs == 2) {
+        fill_block_direct_sum_BCs(crse_level, fine_level, Rhs, phi);
+        return;
+    }
+
     BL_PROFILE("Gravity::fill_direct_sum_BCs()");
     
     BL_ASSERT(crse_level==0);
@@ -2849,6 +3237,328 @@ Gravity::fill_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiF
 #endif
     }
 
+}
+
+void
+Gravity::fill_block_direct_sum_BCs(int crse_level, int fine_level, const Vector<MultiFab*>& Rhs, MultiFab& phi)
+{
+    BL_PROFILE("Gravity::fill_block_direct_sum_BCs()");
+
+    BL_ASSERT(crse_level==0);
+
+    const Real strt = ParallelDescriptor::second();
+
+    const Geometry& crse_geom = parent->Geom(crse_level);
+
+    // The boundary points are the ghost zones just outside of the
+    // coarse domain (see fill_direct_sum_BCs), and all six faces are
+    // packed into a single buffer so that we only need one reduction.
+
+    const Box bc_box = amrex::grow(crse_geom.Domain(), 1);
+
+    const Dim3 bc_lo = amrex::lbound(bc_box);
+    const Dim3 bc_hi = amrex::ubound(bc_box);
+
+    const Long nx = bc_box.length(0);
+    const Long ny = bc_box.length(1);
+    const Long nz = bc_box.length(2);
+
+    const Long nXY = nx * ny;
+    const Long nXZ = nx * nz;
+    const Long nYZ = ny * nz;
+
+    const Long nbc = 2 * (nXY + nXZ + nYZ);
+
+    // because the number of elements in mpi_reduce is int
+    BL_ASSERT(nbc <= std::numeric_limits<int>::max());
+
+    RealVector bc_vals(nbc, 0.0_rt);
+    Real* const bc = bc_vals.dataPtr();
+
+    GpuArray<Real, 3> bc_dx;
+    GpuArray<Real, 3> problo;
+    GpuArray<Real, 3> probhi;
+    for (int n = 0; n < 3; ++n) {
+        bc_dx[n] = crse_geom.CellSizeArray()[n];
+        problo[n] = crse_geom.ProbLoArray()[n];
+        probhi[n] = crse_geom.ProbHiArray()[n];
+    }
+
+    GpuArray<bool, 3> doSymmetricAddLo {false};
+    GpuArray<bool, 3> doSymmetricAddHi {false};
+    bool doSymmetricAdd {false};
+
+    for (int b = 0; b < 3; ++b) {
+        if (phys_bc->lo(b) == amrex::PhysBCType::symmetry) {
+            doSymmetricAddLo[b] = true;
+            doSymmetricAdd      = true;
+        }
+
+        if (phys_bc->hi(b) == amrex::PhysBCType::symmetry) {
+            doSymmetricAddHi[b] = true;
+            doSymmetricAdd      = true;
+        }
+    }
+
+    const int block_size = gravity::direct_sum_block_size;
+    const Real theta = gravity::direct_sum_theta;
+
+    if (block_size < 1) {
+        amrex::Error("gravity.direct_sum_block_size must be positive");
+    }
+
+    for (int lev = crse_level; lev <= fine_level; ++lev) {
+
+        // Create a local copy of the RHS so that we can mask it, and
+        // store the mass of each zone in it.
+
+        MultiFab source(Rhs[lev - crse_level]->boxArray(),
+                        Rhs[lev - crse_level]->DistributionMap(),
+                        1, 0);
+
+        MultiFab::Copy(source, *Rhs[lev - crse_level], 0, 0, 1, 0);
+
+        if (lev < fine_level) {
+            const MultiFab& mask = dynamic_cast<Castro*>(&(parent->getLevel(lev+1)))->build_fine_mask();
+            MultiFab::Multiply(source, mask, 0, 0, 1, 0);
+        }
+
+        MultiFab::Multiply(source, *volume[lev], 0, 0, 1, 0);
+
+        const auto dx = parent->Geom(lev).CellSizeArray();
+
+        // Divide the boxes we own into blocks.
+
+        Gpu::ManagedVector<direct_sum_block_t> block_vec;
+
+        for (MFIter mfi(source); mfi.isValid(); ++mfi) {
+
+            const Box& bx = mfi.validbox();
+            const Box cbx = amrex::coarsen(bx, block_size);
+
+            for (BoxIterator bit(cbx); bit.ok(); ++bit) {
+
+                Box blk(bit() * block_size, bit() * block_size + (block_size - 1));
+                blk &= bx;
+
+                direct_sum_block_t b;
+
+                b.box = mfi.LocalIndex();
+                b.lo = amrex::lbound(blk);
+                b.hi = amrex::ubound(blk);
+
+                b.width = 0.0_rt;
+                for (int n = 0; n < 3; ++n) {
+                    b.width = amrex::max(b.width, static_cast<Real>(blk.length(n)) * dx[n]);
+                    b.center[n] = problo[n] + 0.5_rt * static_cast<Real>(blk.smallEnd(n) + blk.bigEnd(n) + 1) * dx[n];
+                    b.dipole[n] = 0.0_rt;
+                }
+
+                b.mass = 0.0_rt;
+
+                block_vec.push_back(b);
+            }
+
+        }
+
+        const int nblocks = static_cast<int>(block_vec.size());
+
+        if (nblocks == 0) {
+            continue;
+        }
+
+        direct_sum_block_t* const blocks = block_vec.dataPtr();
+
+        const auto mass = source.const_arrays();
+
+        // Compute the moments of each block.
+
+        auto compute_moments = [=] AMREX_GPU_DEVICE (int ib) noexcept
+        {
+            direct_sum_block_t& b = blocks[ib];
+
+            for (int k = b.lo.z; k <= b.hi.z; ++k) {
+                const Real z = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - b.center[2];
+                for (int j = b.lo.y; j <= b.hi.y; ++j) {
+                    const Real y = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - b.center[1];
+                    for (int i = b.lo.x; i <= b.hi.x; ++i) {
+                        const Real x = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - b.center[0];
+
+                        const Real m = mass[b.box](i,j,k);
+
+                        b.mass += m;
+                        b.dipole[0] += m * x;
+                        b.dipole[1] += m * y;
+                        b.dipole[2] += m * z;
+                    }
+                }
+            }
+        };
+
+        // Evaluate the potential at each boundary point, opening only
+        // the blocks that are too close to be approximated by their
+        // monopole and dipole moments.
+
+        auto add_potential = [=] AMREX_GPU_DEVICE (Long p) noexcept
+        {
+            const GpuArray<Real, 3> locb = direct_sum_bc_location(p, bc_lo, bc_hi, problo, probhi, bc_dx);
+
+            Real phi_b = 0.0_rt;
+
+            for (int ib = 0; ib < nblocks; ++ib) {
+
+                const direct_sum_block_t& b = blocks[ib];
+
+                const Real rx = locb[0] - b.center[0];
+                const Real ry = locb[1] - b.center[1];
+                const Real rz = locb[2] - b.center[2];
+
+                const Real r = std::sqrt(rx * rx + ry * ry + rz * rz);
+
+                if (b.width < theta * r) {
+
+                    const Real rinv = 1.0_rt / r;
+
+                    phi_b -= C::Gconst * rinv * (b.mass + (b.dipole[0] * rx + b.dipole[1] * ry + b.dipole[2] * rz) * rinv * rinv);
+
+                    // The images across symmetric boundaries are at
+                    // least as far away as the block itself, so the
+                    // same approximation holds for them.  We put the
+                    // image mass at the block's center of mass.
+
+                    if (doSymmetricAdd) {
+
+                        GpuArray<Real, 3> loc;
+                        for (int n = 0; n < 3; ++n) {
+                            loc[n] = b.center[n];
+                            if (b.mass != 0.0_rt) {
+                                loc[n] += b.dipole[n] / b.mass;
+                            }
+                        }
+
+                        phi_b += direct_sum_symmetric_add(loc, locb, problo, probhi,
+                                                          b.mass, 1.0_rt,
+                                                          doSymmetricAddLo, doSymmetricAddHi);
+
+                    }
+
+                }
+                else {
+
+                    for (int k = b.lo.z; k <= b.hi.z; ++k) {
+                        for (int j = b.lo.y; j <= b.hi.y; ++j) {
+                            for (int i = b.lo.x; i <= b.hi.x; ++i) {
+
+                                GpuArray<Real, 3> loc;
+                                loc[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0];
+                                loc[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1];
+                                loc[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2];
+
+                                const Real m = mass[b.box](i,j,k);
+
+                                const Real rr = std::sqrt((loc[0] - locb[0]) * (loc[0] - locb[0]) +
+                                                          (loc[1] - locb[1]) * (loc[1] - locb[1]) +
+                                                          (loc[2] - locb[2]) * (loc[2] - locb[2]));
+
+                                phi_b -= C::Gconst * m / rr;
+
+                                if (doSymmetricAdd) {
+
+                                    phi_b += direct_sum_symmetric_add(loc, locb, problo, probhi,
+                                                                      m, 1.0_rt,
+                                                                      doSymmetricAddLo, doSymmetricAddHi);
+
+                                }
+
+                            }
+                        }
+                    }
+
+                }
+
+            }
+
+            bc[p] += phi_b;
+        };
+
+#ifdef AMREX_USE_GPU
+        amrex::ParallelFor(nblocks, compute_moments);
+        amrex::ParallelFor(nbc, add_potential);
+        Gpu::streamSynchronize();
+#else
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int ib = 0; ib < nblocks; ++ib) {
+            compute_moments(ib);
+        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+        for (Long p = 0; p < nbc; ++p) {
+            add_potential(p);
+        }
+#endif
+
+    } // end loop over levels
+
+    ParallelDescriptor::ReduceRealSum(bc, static_cast<int>(nbc));
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx= mfi.growntilebox();
+
+        auto p = phi[mfi].array();
+
+        // We use the same precedence as fill_direct_sum_BCs at the
+        // domain edges and corners: z faces, then y, then x.
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const Long ii = i - bc_lo.x;
+            const Long jj = j - bc_lo.y;
+            const Long kk = k - bc_lo.z;
+
+            if (k == bc_lo.z) {
+                p(i,j,k) = bc[ii + nx * jj];
+            }
+            else if (k == bc_hi.z) {
+                p(i,j,k) = bc[nXY + ii + nx * jj];
+            }
+            else if (j == bc_lo.y) {
+                p(i,j,k) = bc[2 * nXY + ii + nx * kk];
+            }
+            else if (j == bc_hi.y) {
+                p(i,j,k) = bc[2 * nXY + nXZ + ii + nx * kk];
+            }
+            else if (i == bc_lo.x) {
+                p(i,j,k) = bc[2 * (nXY + nXZ) + jj + ny * kk];
+            }
+            else if (i == bc_hi.x) {
+                p(i,j,k) = bc[2 * (nXY + nXZ) + nYZ + jj + ny * kk];
+            }
+        });
+    }
+
+    if (gravity::verbose)
+    {
+        const int IOProc = ParallelDescriptor::IOProcessorNumber();
+        Real      end    = ParallelDescriptor::second() - strt;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(end,IOProc);
+        amrex::Print() << "Gravity::fill_block_direct_sum_BCs() time = " << end << std::endl << std::endl;
+#ifdef BL_LAZY
+        });
+#endif
+    }
+
 }
 #endif
 
@@ -3673,6 +4383,11 @@ Gravity::solve_phi_with_mlmg (int crse_level, int fine_level,
 
     Real abs_eps = abs_tol[fine_level] * max_rhs;
 
+    if (rel_eps > 0.0 && loose_rel_tol > rel_eps) {
+        abs_eps *= loose_rel_tol / rel_eps;
+        rel_eps = loose_rel_tol;
+    }
+
     Vector<const MultiFab*> crhs{rhs.begin(), rhs.end()};
     Vector<std::array<MultiFab*,AMREX_SPACEDIM> > gp;
     for (const auto& x : grad_phi) {
@@ -11,6 +11,9 @@
 
 #include <advection_util.H>
 
+#include <algorithm>
+#include <unistd.h>
+
 using namespace amrex;
 
 advance_status
@@ -77,17 +80,21 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
   }
 #endif
 
-  // Record a running total of the number of bytes allocated as temporary Fab data.
+  // The temporary Fab data comes from a scratch pool that is kept
+  // across calls. Make sure it has a set of slots for each thread /
+  // stream, and reset its running total of the number of bytes
+  // handed out.
+
+  hydro_scratch.define();
+  hydro_scratch.resetBytesRequested();
 
-  size_t fab_size = 0;
 #ifdef AMREX_USE_GPU
   size_t mf_size = 0;
 #endif
   IntVect maximum_tile_size{0};
 
   // Our strategy for launching work on GPUs in the hydro is incompatible with OpenMP,
-  // throw an error if the user is trying this. If this were to ever change, it would
-  // require at minimum doing a safe atomic update on the running fab_size total.
+  // throw an error if the user is trying this.
 
 #if defined(AMREX_USE_OMP) && defined(AMREX_USE_GPU)
   amrex::Error("USE_OMP=TRUE and USE_GPU=TRUE are not concurrently supported in Castro");
@@ -122,6 +129,23 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
    }
 #endif
 
+#ifndef AMREX_USE_GPU
+  // If we are tuning the hydro tile size, each hydro update (after a
+  // warm-up one) is done with a different candidate tile size and
+  // timed. This is skipped for local retries, since they only redo
+  // part of the level.
+
+  const bool tune_tile_size = castro::hydro_tile_size_tuning == 1 &&
+                              hydro_tile_size_has_been_tuned == 0 &&
+                              retry_local_pass == 0;
+
+  if (tune_tile_size) {
+      select_hydro_tile_size_candidate();
+  }
+
+  const Real tile_strt_time = ParallelDescriptor::second();
+#endif
+
 #ifdef _OPENMP
 #ifdef RADIATION
 #pragma omp parallel reduction(max:nstep_fsp)
@@ -136,59 +160,60 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 #endif
 
     // Declare local storage now. This should be done outside the
-    // MFIter loop, and then we will resize the Fabs in each MFIter
-    // loop iteration. We use the async arenato ensure that their
-    // memory is saved until it is no longer needed (only relevant for
-    // the asynchronous case, usually on GPUs).
-
-    FArrayBox shk(The_Async_Arena());
-    FArrayBox q(The_Async_Arena()), qaux(The_Async_Arena());
-    FArrayBox rho_inv(The_Async_Arena());
-    FArrayBox src_q(The_Async_Arena());
-    FArrayBox qxm(The_Async_Arena()), qxp(The_Async_Arena());
+    // MFIter loop, and then in each MFIter loop iteration the Fabs
+    // are pointed at memory from the level's scratch pool, which
+    // persists from one call to the next (see hydro_scratch.H).
+
+    FArrayBox shk;
+    FArrayBox q, qaux;
+    FArrayBox rho_inv;
+    FArrayBox src_q;
+    FArrayBox qxm, qxp;
 #if AMREX_SPACEDIM >= 2
-    FArrayBox qym(The_Async_Arena()), qyp(The_Async_Arena());
+    FArrayBox qym, qyp;
 #endif
 #if AMREX_SPACEDIM == 3
-    FArrayBox qzm(The_Async_Arena()), qzp(The_Async_Arena());
+    FArrayBox qzm, qzp;
 #endif
-    FArrayBox div(The_Async_Arena());
+    FArrayBox div;
 #if AMREX_SPACEDIM >= 2
-    FArrayBox ftmp1(The_Async_Arena()), ftmp2(The_Async_Arena());
+    FArrayBox ftmp1, ftmp2;
 #ifdef RADIATION
-    FArrayBox rftmp1(The_Async_Arena()), rftmp2(The_Async_Arena());
+    FArrayBox rftmp1, rftmp2;
 #endif
-    FArrayBox qgdnvtmp1(The_Async_Arena()), qgdnvtmp2(The_Async_Arena());
-    FArrayBox ql(The_Async_Arena()), qr(The_Async_Arena());
+    FArrayBox qgdnvtmp1, qgdnvtmp2;
+    FArrayBox ql, qr;
 #endif
-    Vector<FArrayBox> flux, qe;
-    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
-        flux.push_back(FArrayBox(The_Async_Arena()));
-        qe.push_back(FArrayBox(The_Async_Arena()));
-    }
+    Vector<FArrayBox> flux(AMREX_SPACEDIM), qe(AMREX_SPACEDIM);
 
 #ifdef RADIATION
-    Vector<FArrayBox> rad_flux;
-    for (int n = 0; n < AMREX_SPACEDIM; ++n) {
-        rad_flux.push_back(FArrayBox(The_Async_Arena()));
-    }
+    Vector<FArrayBox> rad_flux(AMREX_SPACEDIM);
 #endif
 #if AMREX_SPACEDIM <= 2
-    FArrayBox pradial(The_Async_Arena());
+    FArrayBox pradial;
 #endif
 #if AMREX_SPACEDIM == 3
-    FArrayBox qmyx(The_Async_Arena()), qpyx(The_Async_Arena());
-    FArrayBox qmzx(The_Async_Arena()), qpzx(The_Async_Arena());
-    FArrayBox qmxy(The_Async_Arena()), qpxy(The_Async_Arena());
-    FArrayBox qmzy(The_Async_Arena()), qpzy(The_Async_Arena());
-    FArrayBox qmxz(The_Async_Arena()), qpxz(The_Async_Arena());
-    FArrayBox qmyz(The_Async_Arena()), qpyz(The_Async_Arena());
+    FArrayBox qmyx, qpyx;
+    FArrayBox qmzx, qpzx;
+    FArrayBox qmxy, qpxy;
+    FArrayBox qmzy, qpzy;
+    FArrayBox qmxz, qpxz;
+    FArrayBox qmyz, qpyz;
 #endif
 
     MultiFab& old_source = get_old_data(Source_Type);
 
     for (MFIter mfi(S_new, hydro_tile_size); mfi.isValid(); ++mfi) {
 
+      // In the second pass of a local retry, only the boxes touching
+      // the region being redone need to be advanced.
+
+      if (retry_local_pass == 2 && retry_local_active_box[mfi.index()] == 0) {
+          continue;
+      }
+
+      hydro_scratch.beginTile();
+
       // the valid region box
       const Box& bx = mfi.tilebox();
 
@@ -201,23 +226,20 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       const Box& qbx3 = amrex::grow(bx, 3);
 
 #ifdef RADIATION
-      q.resize(qbx, NQ);
+      q = hydro_scratch.fab(qbx, NQ);
 #else
       // note: we won't store the passives in q, so we'll compute their
       // primitive versions on demand as needed
-      q.resize(qbx, NQTHERM);
+      q = hydro_scratch.fab(qbx, NQTHERM);
 #endif
-      fab_size += q.nBytes();
       Array4<Real> const q_arr = q.array();
 
-      qaux.resize(qbx, NQAUX);
-      fab_size += qaux.nBytes();
+      qaux = hydro_scratch.fab(qbx, NQAUX);
       Array4<Real> const qaux_arr = qaux.array();
 
       Array4<Real const> const U_old_arr = Sborder.array(mfi);
 
-      rho_inv.resize(qbx3, 1);
-      fab_size += rho_inv.nBytes();
+      rho_inv = hydro_scratch.fab(qbx3, 1);
       Array4<Real> const rho_inv_arr = rho_inv.array();
 
       amrex::ParallelFor(qbx3,
@@ -253,8 +275,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       const Box& gzbx = amrex::grow(zbx, 1);
 #endif
 
-      shk.resize(obx, 1);
-      fab_size += shk.nBytes();
+      shk = hydro_scratch.fab(obx, 1);
 
       Array4<Real> const shk_arr = shk.array();
 
@@ -269,8 +290,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
       // get the primitive variable hydro sources
 
-      src_q.resize(qbx3, NQSRC);
-      fab_size += src_q.nBytes();
+      src_q = hydro_scratch.fab(qbx3, NQSRC);
       Array4<Real> const src_q_arr = src_q.array();
 
       Array4<Real> const old_src_arr = old_source.array(mfi);
@@ -295,21 +315,17 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
       // work on the interface states
 
-      qxm.resize(obx, NQ);
-      fab_size += qxm.nBytes();
+      qxm = hydro_scratch.fab(obx, NQ);
 
-      qxp.resize(obx, NQ);
-      fab_size += qxp.nBytes();
+      qxp = hydro_scratch.fab(obx, NQ);
 
       Array4<Real> const qxm_arr = qxm.array();
       Array4<Real> const qxp_arr = qxp.array();
 
 #if AMREX_SPACEDIM >= 2
-      qym.resize(obx, NQ);
-      fab_size += qym.nBytes();
+      qym = hydro_scratch.fab(obx, NQ);
 
-      qyp.resize(obx, NQ);
-      fab_size += qyp.nBytes();
+      qyp = hydro_scratch.fab(obx, NQ);
 
       Array4<Real> const qym_arr = qym.array();
       Array4<Real> const qyp_arr = qyp.array();
@@ -317,11 +333,9 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 #endif
 
 #if AMREX_SPACEDIM == 3
-      qzm.resize(obx, NQ);
-      fab_size += qzm.nBytes();
+      qzm = hydro_scratch.fab(obx, NQ);
 
-      qzp.resize(obx, NQ);
-      fab_size += qzp.nBytes();
+      qzp = hydro_scratch.fab(obx, NQ);
 
       Array4<Real> const qzm_arr = qzm.array();
       Array4<Real> const qzp_arr = qzp.array();
@@ -384,64 +398,53 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
       }
 
-      div.resize(obx, 1);
-      fab_size += div.nBytes();
+      div = hydro_scratch.fab(obx, 1);
       auto div_arr = div.array();
 
       // compute divu -- we'll use this later when doing the artificial viscosity
       divu(obx, q_arr, div_arr);
 
-      flux[0].resize(gxbx, NUM_STATE);
-      fab_size += flux[0].nBytes();
+      flux[0] = hydro_scratch.fab(gxbx, NUM_STATE);
       Array4<Real> const flux0_arr = (flux[0]).array();
 
-      qe[0].resize(gxbx, NGDNV);
+      qe[0] = hydro_scratch.fab(gxbx, NGDNV);
       auto qex_arr = qe[0].array();
-      fab_size += qe[0].nBytes();
 
 #ifdef RADIATION
-      rad_flux[0].resize(gxbx, Radiation::nGroups);
-      fab_size += rad_flux[0].nBytes();
+      rad_flux[0] = hydro_scratch.fab(gxbx, Radiation::nGroups);
       auto rad_flux0_arr = (rad_flux[0]).array();
 #endif
 
 #if AMREX_SPACEDIM >= 2
-      flux[1].resize(gybx, NUM_STATE);
-      fab_size += flux[1].nBytes();
+      flux[1] = hydro_scratch.fab(gybx, NUM_STATE);
       Array4<Real> const flux1_arr = (flux[1]).array();
 
-      qe[1].resize(gybx, NGDNV);
+      qe[1] = hydro_scratch.fab(gybx, NGDNV);
       auto qey_arr = qe[1].array();
-      fab_size += qe[1].nBytes();
 
 #ifdef RADIATION
-      rad_flux[1].resize(gybx, Radiation::nGroups);
-      fab_size += rad_flux[1].nBytes();
+      rad_flux[1] = hydro_scratch.fab(gybx, Radiation::nGroups);
       auto const rad_flux1_arr = (rad_flux[1]).array();
 #endif
 #endif
 
 #if AMREX_SPACEDIM == 3
-      flux[2].resize(gzbx, NUM_STATE);
-      fab_size += flux[2].nBytes();
+      flux[2] = hydro_scratch.fab(gzbx, NUM_STATE);
       Array4<Real> const flux2_arr = (flux[2]).array();
 
-      qe[2].resize(gzbx, NGDNV);
+      qe[2] = hydro_scratch.fab(gzbx, NGDNV);
       auto qez_arr = qe[2].array();
-      fab_size += qe[2].nBytes();
 
 #ifdef RADIATION
-      rad_flux[2].resize(gzbx, Radiation::nGroups);
-      fab_size += rad_flux[2].nBytes();
+      rad_flux[2] = hydro_scratch.fab(gzbx, Radiation::nGroups);
       auto const rad_flux2_arr = (rad_flux[2]).array();
 #endif
 #endif
 
 #if AMREX_SPACEDIM <= 2
       if (!Geom().IsCartesian()) {
-          pradial.resize(xbx, 1);
+          pradial = hydro_scratch.fab(xbx, 1);
       }
-      fab_size += pradial.nBytes();
 #endif
 
 #ifdef SIMPLIFIED_SDC
@@ -477,41 +480,33 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
 
 #if AMREX_SPACEDIM >= 2
-      ftmp1.resize(obx, NUM_STATE);
+      ftmp1 = hydro_scratch.fab(obx, NUM_STATE);
       auto ftmp1_arr = ftmp1.array();
-      fab_size += ftmp1.nBytes();
 
-      ftmp2.resize(obx, NUM_STATE);
+      ftmp2 = hydro_scratch.fab(obx, NUM_STATE);
       auto ftmp2_arr = ftmp2.array();
-      fab_size += ftmp2.nBytes();
 
 #ifdef RADIATION
-      rftmp1.resize(obx, Radiation::nGroups);
+      rftmp1 = hydro_scratch.fab(obx, Radiation::nGroups);
       auto rftmp1_arr = rftmp1.array();
-      fab_size += rftmp1.nBytes();
 
-      rftmp2.resize(obx, Radiation::nGroups);
+      rftmp2 = hydro_scratch.fab(obx, Radiation::nGroups);
       auto rftmp2_arr = rftmp2.array();
-      fab_size += rftmp2.nBytes();
 #endif
 
-      qgdnvtmp1.resize(obx, NGDNV);
+      qgdnvtmp1 = hydro_scratch.fab(obx, NGDNV);
       auto qgdnvtmp1_arr = qgdnvtmp1.array();
-      fab_size += qgdnvtmp1.nBytes();
 
 #if AMREX_SPACEDIM == 3
-      qgdnvtmp2.resize(obx, NGDNV);
+      qgdnvtmp2 = hydro_scratch.fab(obx, NGDNV);
       auto qgdnvtmp2_arr = qgdnvtmp2.array();
-      fab_size += qgdnvtmp2.nBytes();
 #endif
 
-      ql.resize(obx, NQ);
+      ql = hydro_scratch.fab(obx, NQ);
       auto ql_arr = ql.array();
-      fab_size += ql.nBytes();
 
-      qr.resize(obx, NQ);
+      qr = hydro_scratch.fab(obx, NQ);
       auto qr_arr = qr.array();
-      fab_size += qr.nBytes();
 #endif
 
 
@@ -677,13 +672,11 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       // [lo(1), lo(2), lo(3)-1], [hi(1), hi(2)+1, hi(3)+1]
       const Box& tyxbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(0,0,1)));
 
-      qmyx.resize(tyxbx, NQ);
+      qmyx = hydro_scratch.fab(tyxbx, NQ);
       auto qmyx_arr = qmyx.array();
-      fab_size += qmyx.nBytes();
 
-      qpyx.resize(tyxbx, NQ);
+      qpyx = hydro_scratch.fab(tyxbx, NQ);
       auto qpyx_arr = qpyx.array();
-      fab_size += qpyx.nBytes();
 
       // ftmp1 = fx
       // rftmp1 = rfx
@@ -706,13 +699,11 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       // [lo(1), lo(2)-1, lo(3)], [hi(1), hi(2)+1, hi(3)+1]
       const Box& tzxbx = amrex::grow(zbx, IntVect(AMREX_D_DECL(0,1,0)));
 
-      qmzx.resize(tzxbx, NQ);
+      qmzx = hydro_scratch.fab(tzxbx, NQ);
       auto qmzx_arr = qmzx.array();
-      fab_size += qmzx.nBytes();
 
-      qpzx.resize(tzxbx, NQ);
+      qpzx = hydro_scratch.fab(tzxbx, NQ);
       auto qpzx_arr = qpzx.array();
-      fab_size += qpzx.nBytes();
 
       trans_single(tzxbx, 0, 2,
                    qzm_arr, qmzx_arr,
@@ -749,13 +740,11 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       // [lo(1), lo(2), lo(3)-1], [hi(1)+1, hi(2), lo(3)+1]
       const Box& txybx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,0,1)));
 
-      qmxy.resize(txybx, NQ);
+      qmxy = hydro_scratch.fab(txybx, NQ);
       auto qmxy_arr = qmxy.array();
-      fab_size += qmxy.nBytes();
 
-      qpxy.resize(txybx, NQ);
+      qpxy = hydro_scratch.fab(txybx, NQ);
       auto qpxy_arr = qpxy.array();
-      fab_size += qpxy.nBytes();
 
       // ftmp1 = fy
       // rftmp1 = rfy
@@ -778,13 +767,11 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2), lo(3)+1]
       const Box& tzybx = amrex::grow(zbx, IntVect(AMREX_D_DECL(1,0,0)));
 
-      qmzy.resize(tzybx, NQ);
+      qmzy = hydro_scratch.fab(tzybx, NQ);
       auto qmzy_arr = qmzy.array();
-      fab_size += qmzy.nBytes();
 
-      qpzy.resize(tzybx, NQ);
+      qpzy = hydro_scratch.fab(tzybx, NQ);
       auto qpzy_arr = qpzy.array();
-      fab_size += qpzy.nBytes();
 
       // ftmp1 = fy
       // rftmp1 = rfy
@@ -824,13 +811,11 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       // [lo(1)-1, lo(2)-1, lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
       const Box& txzbx = amrex::grow(xbx, IntVect(AMREX_D_DECL(0,1,0)));
 
-      qmxz.resize(txzbx, NQ);
+      qmxz = hydro_scratch.fab(txzbx, NQ);
       auto qmxz_arr = qmxz.array();
-      fab_size += qmxz.nBytes();
 
-      qpxz.resize(txzbx, NQ);
+      qpxz = hydro_scratch.fab(txzbx, NQ);
       auto qpxz_arr = qpxz.array();
-      fab_size += qpxz.nBytes();
 
       // ftmp1 = fz
       // rftmp1 = rfz
@@ -853,13 +838,11 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
       // [lo(1)-1, lo(2), lo(3)], [hi(1)+1, hi(2)+1, lo(3)]
       const Box& tyzbx = amrex::grow(ybx, IntVect(AMREX_D_DECL(1,0,0)));
 
-      qmyz.resize(tyzbx, NQ);
+      qmyz = hydro_scratch.fab(tyzbx, NQ);
       auto qmyz_arr = qmyz.array();
-      fab_size += qmyz.nBytes();
 
-      qpyz.resize(tyzbx, NQ);
+      qpyz = hydro_scratch.fab(tyzbx, NQ);
       auto qpyz_arr = qpyz.array();
-      fab_size += qpyz.nBytes();
 
       // ftmp1 = fz
       // rftmp1 = rfz
@@ -1365,7 +1348,7 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
                                                                    mfi.validbox().numPts());
 
               // If we're tuning the hydro tile size during this timestep, we will record
-              // the total amount of additional memory allocated, relative to the size of S_new.
+              // the total amount of scratch memory handed out, relative to the size of S_new.
               // Then we will reset the tile size so that it is no larger than the requested
               // memory footprint.
 
@@ -1381,10 +1364,9 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
               maximum_tile_size[2] = amrex::max(maximum_tile_size[2], bx.bigEnd(2) - mfi.validbox().smallEnd(2) + 1);
 #endif
 
-              if (fab_size >= castro::hydro_memory_footprint_ratio * mf_size) {
+              if (hydro_scratch.bytesRequested() >= castro::hydro_memory_footprint_ratio * mf_size) {
                   // If we reached the memory limit, set the tile size to the current
                   // maximum tile size.
-                  Gpu::synchronize();
                   hydro_tile_size = maximum_tile_size;
                   hydro_tile_size_has_been_tuned = 1;
               }
@@ -1402,17 +1384,10 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
               }
 
           }
-          else {
-              // If we have already tuned the parameter, then synchronize each time the
-              // outstanding number of active bytes is larger than our ratio.
 
-              if (fab_size >= castro::hydro_memory_footprint_ratio * mf_size) {
-                  Gpu::synchronize();
-
-                  // Reset the counter for the next sequence of tiles.
-                  fab_size = 0;
-              }
-          }
+          // Once the tile size is tuned, there is nothing more to do: the
+          // scratch memory is reused from tile to tile rather than
+          // accumulating until the next synchronization.
       }
 #endif
 
@@ -1420,6 +1395,12 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 
   } // OMP loop
 
+#ifndef AMREX_USE_GPU
+  if (tune_tile_size) {
+      record_hydro_tile_size_candidate(ParallelDescriptor::second() - tile_strt_time);
+  }
+#endif
+
 #ifdef RADIATION
   if (radiation->verbose>=1) {
 #ifdef BL_LAZY
@@ -1499,7 +1480,237 @@ Castro::construct_ctu_hydro_source(Real time, Real dt)
 #endif
     }
 
+  if (verbose > 1)
+    {
+      const int IOProc = ParallelDescriptor::IOProcessorNumber();
+      Long peak_bytes  = static_cast<Long>(hydro_scratch.peakBytes());
+      Long total_bytes = static_cast<Long>(hydro_scratch.nBytes());
+
+#ifdef BL_LAZY
+      Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceLongMax(peak_bytes, IOProc);
+        ParallelDescriptor::ReduceLongMax(total_bytes, IOProc);
+
+        amrex::Print() << "Castro::construct_ctu_hydro_source() scratch: peak bytes per tile = " << peak_bytes
+                       << ", bytes allocated = " << total_bytes << " on level " << level << "\n" << "\n";
+#ifdef BL_LAZY
+        });
+#endif
+    }
+
 #endif
 
   return status;
 }
+
+
+Long
+Castro::hydro_tile_footprint(const Box& bx)
+{
+    // This mirrors the temporaries allocated in the MFIter loop of
+    // construct_ctu_hydro_source.  The interface states, fluxes, and
+    // transverse states all live on (approximately) the tile grown by
+    // one zone, while the primitive state and its sources live on the
+    // tile grown by NUM_GROW zones.
+
+    const Long nq = Box(bx).grow(NUM_GROW).numPts();
+    const Long no = Box(bx).grow(1).numPts();
+
+#ifdef RADIATION
+    Long ncomp_q = static_cast<Long>(NQ) + NQAUX + NQSRC + 2;
+#else
+    Long ncomp_q = static_cast<Long>(NQTHERM) + NQAUX + NQSRC + 2;
+#endif
+
+    // shk, div, the interface states, and the fluxes
+
+    Long ncomp_o = 2 + 2 * AMREX_SPACEDIM * NQ + AMREX_SPACEDIM * (NUM_STATE + NGDNV);
+
+#if AMREX_SPACEDIM >= 2
+    // ftmp1, ftmp2, qgdnvtmp1, qgdnvtmp2, ql, qr
+    ncomp_o += 2 * (NUM_STATE + NGDNV + NQ);
+#endif
+#if AMREX_SPACEDIM == 3
+    // qmyx, qpyx, ..., qmyz, qpyz
+    ncomp_o += 12 * NQ;
+#endif
+
+    return static_cast<Long>(sizeof(Real)) * (ncomp_q * nq + ncomp_o * no);
+}
+
+
+
+void
+Castro::select_hydro_tile_size_candidate()
+{
+    if (hydro_tile_size_candidates.empty()) {
+
+        // Build the list of candidates. We want tiles that are long in
+        // x, for vectorization, and whose temporaries fit in the L2 cache.
+
+        Long cache_bytes = castro::hydro_tile_size_cache_bytes;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        if (cache_bytes <= 0) {
+            cache_bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        }
+#endif
+        if (cache_bytes <= 0) {
+            cache_bytes = 1024 * 1024;
+        }
+
+        // Tiles larger than the largest box on this level are
+        // equivalent to the box, so we compare candidates after
+        // clipping them to it.
+
+        IntVect largest_box{1};
+        for (int i = 0; i < grids.size(); ++i) {
+            largest_box = amrex::max(largest_box, grids[i].length());
+        }
+
+        Vector<IntVect> trial;
+
+#if AMREX_SPACEDIM == 1
+        for (int nx : {128, 256, 512, 1024, 4096}) {
+            trial.push_back(IntVect(nx));
+        }
+#else
+        for (int nx : {1024, 64, 32}) {
+            for (int ny : {4, 8, 16, 32, 64}) {
+#if AMREX_SPACEDIM == 2
+                trial.push_back(IntVect(nx, ny));
+#else
+                if (ny <= 32) {
+                    trial.push_back(IntVect(nx, ny, ny));
+                }
+#endif
+            }
+        }
+#endif
+
+        // Keep the candidates that fit in cache, largest first, since
+        // smaller tiles only add overhead from the ghost zones.
+
+        Vector<std::pair<Long, IntVect>> fits;
+        Vector<std::pair<Long, IntVect>> too_big;
+
+        for (const auto& t : trial) {
+            const IntVect clipped = amrex::min(t, largest_box);
+
+            bool duplicate = false;
+            for (const auto& f : fits) {
+                duplicate = duplicate || amrex::min(f.second, largest_box) == clipped;
+            }
+            for (const auto& f : too_big) {
+                duplicate = duplicate || amrex::min(f.second, largest_box) == clipped;
+            }
+            if (duplicate) {
+                continue;
+            }
+
+            const Long bytes = hydro_tile_footprint(Box(IntVect(0), clipped - 1));
+
+            if (bytes <= cache_bytes) {
+                fits.push_back({bytes, t});
+            } else {
+                too_big.push_back({bytes, t});
+            }
+        }
+
+        std::sort(fits.begin(), fits.end(),
+                  [] (const auto& a, const auto& b) { return a.first > b.first; });
+
+        const int max_candidates = 6;
+
+        for (const auto& f : fits) {
+            if (static_cast<int>(hydro_tile_size_candidates.size()) < max_candidates) {
+                hydro_tile_size_candidates.push_back(f.second);
+            }
+        }
+
+        // If nothing fits, fall back to the smallest tile we tried.
+
+        if (hydro_tile_size_candidates.empty() && !too_big.empty()) {
+            auto smallest = std::min_element(too_big.begin(), too_big.end(),
+                                             [] (const auto& a, const auto& b) { return a.first < b.first; });
+            hydro_tile_size_candidates.push_back(smallest->second);
+        }
+
+        // Always compare against the tile size we started with.
+
+        bool have_default = false;
+        for (const auto& c : hydro_tile_size_candidates) {
+            have_default = have_default || amrex::min(c, largest_box) == amrex::min(hydro_tile_size, largest_box);
+        }
+        if (!have_default) {
+            hydro_tile_size_candidates.push_back(hydro_tile_size);
+        }
+
+        hydro_tile_size_candidate_times.resize(hydro_tile_size_candidates.size(), 0.0_rt);
+
+        if (verbose > 0) {
+            amrex::Print() << "... tuning the hydro tile size (L2 cache = " << cache_bytes << " bytes), candidates:";
+            for (const auto& c : hydro_tile_size_candidates) {
+                amrex::Print() << " " << c;
+            }
+            amrex::Print() << "\n";
+        }
+
+        // The first hydro update is a warm-up with the starting
+        // tile size, since it includes first-touch and allocation
+        // costs that we do not want to charge to any candidate.
+
+        hydro_tile_size_candidate_index = -1;
+        return;
+    }
+
+    ++hydro_tile_size_candidate_index;
+
+    hydro_tile_size = hydro_tile_size_candidates[hydro_tile_size_candidate_index];
+}
+
+
+
+void
+Castro::record_hydro_tile_size_candidate(Real elapsed)
+{
+    ParallelDescriptor::ReduceRealMax(elapsed);
+
+    const int n = hydro_tile_size_candidate_index;
+
+    if (n < 0) {
+        return;
+    }
+
+    // Normalize by the number of zones, since successive hydro updates
+    // may be on different levels.
+
+    hydro_tile_size_candidate_times[n] = elapsed / static_cast<Real>(grids.numPts());
+
+    if (verbose > 0) {
+        amrex::Print() << "... hydro tile size " << hydro_tile_size << ": "
+                       << hydro_tile_size_candidate_times[n] << " s per zone\n";
+    }
+
+    if (n == static_cast<int>(hydro_tile_size_candidates.size()) - 1) {
+
+        int best = 0;
+        for (int i = 1; i <= n; ++i) {
+            if (hydro_tile_size_candidate_times[i] < hydro_tile_size_candidate_times[best]) {
+                best = i;
+            }
+        }
+
+        hydro_tile_size = hydro_tile_size_candidates[best];
+        hydro_tile_size_has_been_tuned = 1;
+
+        for (int i = 0; i < grids.size(); ++i) {
+            largest_box_from_hydro_tile_size_tuning = amrex::max(largest_box_from_hydro_tile_size_tuning,
+                                                                 grids[i].numPts());
+        }
+
+        if (verbose > 0) {
+            amrex::Print() << "... setting the hydro tile size to " << hydro_tile_size << "\n";
+        }
+    }
+}
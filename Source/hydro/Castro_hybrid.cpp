@@ -103,22 +103,7 @@ Castro::fill_hybrid_hydro_source(MultiFab& sources, MultiFab& state_in, Real mul
         amrex::ParallelFor(bx,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
-            GpuArray<Real, 3> loc;
-
-            position(i, j, k, geomdata, loc);
-
-            loc[0] -= problem::center[0];
-            loc[1] -= problem::center[1];
-
-            Real R = amrex::max(std::sqrt(loc[0] * loc[0] + loc[1] * loc[1]),
-                                std::numeric_limits<Real>::min());
-
-            Real rhoInv = 1.0_rt / u(i,j,k,URHO);
-            Real RInv = 1.0_rt / R;
-
-            src(i,j,k,UMR) = src(i,j,k,UMR) + mult_factor * (rhoInv * RInv * RInv * RInv) *
-                                              u(i,j,k,UML) * u(i,j,k,UML);
-
+            src(i,j,k,UMR) = src(i,j,k,UMR) + hybrid_hydro_source_zone(i, j, k, u, geomdata, mult_factor);
         });
     }
 }
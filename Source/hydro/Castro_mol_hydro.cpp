@@ -104,7 +104,7 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
         Real stage_weight = 1.0;
 
         if (time_integration_method == SpectralDeferredCorrections) {
-          stage_weight = node_weights[current_sdc_node];
+          stage_weight = sdc_flux_register_weight();
         }
 
         // get the flattening coefficient
@@ -686,11 +686,14 @@ Castro::construct_mol_hydro_source(Real time, Real dt, MultiFab& A_update)
         // Store the fluxes from this advance -- we weight them by the
         // integrator weight for this stage
 
-        // For SDC, we store node 0 the only time we enter here (the
-        // first iteration) and we store the other nodes only on the
-        // last iteration.
+        // For SDC, the weight accounts for both the node and the
+        // iteration, so that the sum is consistent with the final
+        // update and the reflux is conservative.  Node 0 is only
+        // stored the one time we enter here (the first iteration),
+        // and the other nodes are only stored on the last two
+        // iterations.
         if (time_integration_method == SpectralDeferredCorrections &&
-             (current_sdc_node == 0 || sdc_iteration == sdc_order+sdc_extra-1)) {
+            stage_weight != 0.0_rt) {
 
           for (int idir = 0; idir < AMREX_SPACEDIM; ++idir) {
 
@@ -0,0 +1,147 @@
+#include <hydro_scratch.H>
+
+#include <AMReX_Arena.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_OpenMP.H>
+
+#include <algorithm>
+
+using namespace amrex;
+
+HydroScratch::~HydroScratch ()
+{
+    clear();
+}
+
+void
+HydroScratch::define ()
+{
+#ifdef AMREX_USE_GPU
+    const int nsets = Gpu::Device::numGpuStreams();
+#else
+    const int nsets = OpenMP::get_max_threads();
+#endif
+
+    if (static_cast<int>(m_sets.size()) < nsets) {
+        m_sets.resize(nsets);
+    }
+}
+
+void
+HydroScratch::clear ()
+{
+    if (nBytes() > 0) {
+        // Kernels launched with this memory may still be running.
+        Gpu::streamSynchronizeAll();
+    }
+
+    for (auto& set : m_sets) {
+        for (auto& slot : set.slots) {
+            if (slot.p != nullptr) {
+                The_Arena()->free(slot.p);
+            }
+        }
+    }
+
+    m_sets.clear();
+}
+
+int
+HydroScratch::setIndex ()
+{
+#ifdef AMREX_USE_GPU
+    return Gpu::Device::streamIndex();
+#else
+    return OpenMP::get_thread_num();
+#endif
+}
+
+void
+HydroScratch::beginTile ()
+{
+    AMREX_ASSERT(setIndex() < static_cast<int>(m_sets.size()));
+
+    SlotSet& set = m_sets[setIndex()];
+
+    set.next = 0;
+    set.tile_bytes = 0;
+}
+
+FArrayBox
+HydroScratch::fab (const Box& bx, int ncomp)
+{
+    AMREX_ASSERT(setIndex() < static_cast<int>(m_sets.size()));
+
+    SlotSet& set = m_sets[setIndex()];
+
+    if (set.next == static_cast<int>(set.slots.size())) {
+        set.slots.emplace_back();
+    }
+
+    Slot& slot = set.slots[set.next++];
+
+    const std::size_t bytes = bx.numPts() * ncomp * sizeof(Real);
+
+    if (bytes > slot.bytes) {
+        if (slot.p != nullptr) {
+            // The previous tile on this stream may still be using
+            // this memory.
+            Gpu::streamSynchronize();
+            The_Arena()->free(slot.p);
+        }
+        slot.p = static_cast<Real*>(The_Arena()->alloc(bytes));
+        slot.bytes = bytes;
+    }
+
+    set.tile_bytes += bytes;
+    set.peak_bytes = std::max(set.peak_bytes, set.tile_bytes);
+    set.requested_bytes += bytes;
+
+    return FArrayBox(bx, ncomp, slot.p);
+}
+
+std::size_t
+HydroScratch::nBytes () const
+{
+    std::size_t bytes = 0;
+
+    for (const auto& set : m_sets) {
+        for (const auto& slot : set.slots) {
+            bytes += slot.bytes;
+        }
+    }
+
+    return bytes;
+}
+
+std::size_t
+HydroScratch::peakBytes () const
+{
+    std::size_t bytes = 0;
+
+    for (const auto& set : m_sets) {
+        bytes = std::max(bytes, set.peak_bytes);
+    }
+
+    return bytes;
+}
+
+std::size_t
+HydroScratch::bytesRequested () const
+{
+    std::size_t bytes = 0;
+
+    for (const auto& set : m_sets) {
+        bytes += set.requested_bytes;
+    }
+
+    return bytes;
+}
+
+void
+HydroScratch::resetBytesRequested ()
+{
+    for (auto& set : m_sets) {
+        set.requested_bytes = 0;
+    }
+}
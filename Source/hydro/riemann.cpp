@@ -1,6 +1,7 @@
 #include <Castro.H>
 
 #include <riemann_solvers.H>
+#include <riemann_batch.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
@@ -65,12 +66,35 @@ Castro::cmpflx_plus_godunov(const Box& bx,
     const auto domlo = geom.Domain().loVect3d();
     const auto domhi = geom.Domain().hiVect3d();
 
+    // on CPUs, the CGF solve can be done for batches of interfaces
+    // along each pencil -- this gives the same result as the
+    // per-interface solve below
+
+    bool batched = false;
+
+#if !defined(AMREX_USE_GPU) && !defined(RADIATION) && !defined(HYBRID_MOMENTUM)
+    if (riemann_batched == 1 && riemann_solver == 0 && ppm_temp_fix != 2) {
+        batched = true;
+
+        cmpflx_cgf_batched(bx, idir,
+                           qm, qp, qaux_arr,
+                           flx, qgdnv, store_full_state,
+                           geomdata,
+                           special_bnd_lo, special_bnd_hi,
+                           domlo, domhi);
+    }
+#endif
+
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
 
 
-        if (riemann_solver == 0 || riemann_solver == 1) {
+        if (batched) {
+            // the fluxes and interface state, including the passives,
+            // were already computed above
+
+        } else if (riemann_solver == 0 || riemann_solver == 1) {
             // approximate state Riemann solvers
 
             // first find the interface state on the current interface
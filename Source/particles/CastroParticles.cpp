@@ -1,8 +1,13 @@
 #include <iomanip>
+#include <fstream>
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <sstream>
 #include <string>
 #include <Castro.H>
+#include <AMReX_VisMF.H>
 
 #include <particles_params.H>
 
@@ -13,11 +18,303 @@ using namespace amrex;
 #ifdef AMREX_PARTICLES
 
 AmrTracerParticleContainer* Castro::TracerPC =  0;
+std::unique_ptr<ParticleHistory> Castro::particle_history;
 
 namespace {
     std::vector<int>  timestamp_indices;
     //
+    // the state components, and whether the position and the velocity,
+    // are written to the binary particle history
+    std::vector<int>  history_indices;
+    bool history_position = true;
+    bool history_velocity = true;
+    //
     const std::string chk_tracer_particle_file("Tracer");
+
+    using TracerParIter = ParIter<AMREX_SPACEDIM>;
+
+    //
+    // Spread the low bits of x so that AMREX_SPACEDIM of them can be
+    // interleaved into a single Morton key.
+    //
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    std::uint64_t morton_spread (std::uint64_t x)
+    {
+#if AMREX_SPACEDIM == 3
+        x &= 0x1fffff;
+        x = (x | (x << 32)) & 0x1f00000000ffffULL;
+        x = (x | (x << 16)) & 0x1f0000ff0000ffULL;
+        x = (x | (x <<  8)) & 0x100f00f00f00f00fULL;
+        x = (x | (x <<  4)) & 0x10c30c30c30c30c3ULL;
+        x = (x | (x <<  2)) & 0x1249249249249249ULL;
+#elif AMREX_SPACEDIM == 2
+        x &= 0xffffffff;
+        x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+        x = (x | (x <<  8)) & 0x00ff00ff00ff00ffULL;
+        x = (x | (x <<  4)) & 0x0f0f0f0f0f0f0f0fULL;
+        x = (x | (x <<  2)) & 0x3333333333333333ULL;
+        x = (x | (x <<  1)) & 0x5555555555555555ULL;
+#endif
+        return x;
+    }
+
+    //
+    // Gather the timestamp records of the particles at level lev.  The
+    // interpolation of the requested components of mf is done for all
+    // particles of a tile in a single kernel (in the order the particles
+    // are stored, so it benefits from Castro::sort_tracer_particles).
+    // Each record holds the position (if with_pos), the velocity stored by
+    // AdvectWithUcc (if with_vel), and the interpolated components; ids
+    // holds the id and cpu of each particle.  Particles that would not be
+    // written (invalid, or in no box of the level) are skipped.
+    //
+    void gather_timestamp_records (AmrTracerParticleContainer& pc,
+                                   const MultiFab&             mf,
+                                   int                         lev,
+                                   const std::vector<int>&     indices,
+                                   bool                        with_pos,
+                                   bool                        with_vel,
+                                   std::vector<std::int64_t>&  ids,
+                                   std::vector<double>&        recs)
+    {
+        BL_PROFILE("Castro::gather_timestamp_records()");
+
+        ids.clear();
+        recs.clear();
+
+        const int M = static_cast<int>(indices.size());
+        const int ipos = 0;
+        const int ivel = with_pos ? AMREX_SPACEDIM : 0;
+        const int ival = ivel + (with_vel ? AMREX_SPACEDIM : 0);
+        const int nrec = ival + M;
+
+        const Geometry& geom = pc.Geom(lev);
+        const auto plo = geom.ProbLoArray();
+        const auto dxi = geom.InvCellSizeArray();
+        const BoxArray& ba = mf.boxArray();
+
+        Gpu::DeviceVector<int> d_indices(M);
+        Gpu::copyAsync(Gpu::hostToDevice, indices.begin(), indices.end(), d_indices.begin());
+        const int* idx = d_indices.dataPtr();
+
+        Vector<double> h_rec;
+        Vector<Long> h_id;
+        Vector<int> h_cell;
+
+        for (TracerParIter pti(pc, lev); pti.isValid(); ++pti)
+        {
+            const int np = pti.numParticles();
+            if (np == 0) continue;
+
+            const Box& bx = pti.validbox();
+            const auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            const auto data = mf.const_array(pti);
+
+            Gpu::DeviceVector<double> d_rec(static_cast<Long>(np) * nrec);
+            Gpu::DeviceVector<Long> d_id(2 * np);
+            Gpu::DeviceVector<int> d_cell(AMREX_SPACEDIM * np);
+            double* rec = d_rec.dataPtr();
+            Long* pid = d_id.dataPtr();
+            int* cell = d_cell.dataPtr();
+
+            amrex::ParallelFor(np,
+            [=] AMREX_GPU_DEVICE (int n) noexcept
+            {
+                const auto& p = pstruct[n];
+
+                double* r = rec + static_cast<Long>(n) * nrec;
+
+                int iv[3] = {0, 0, 0};
+                int i0[3] = {0, 0, 0};
+                Real w[3][2] = {{1.0_rt, 0.0_rt}, {1.0_rt, 0.0_rt}, {1.0_rt, 0.0_rt}};
+
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    const Real x = (p.pos(d) - plo[d]) * dxi[d];
+                    iv[d] = static_cast<int>(amrex::Math::floor(x));
+                    const Real lx = x - 0.5_rt;
+                    i0[d] = static_cast<int>(amrex::Math::floor(lx));
+                    w[d][1] = lx - static_cast<Real>(i0[d]);
+                    w[d][0] = 1.0_rt - w[d][1];
+
+                    cell[AMREX_SPACEDIM*n+d] = iv[d];
+
+                    if (with_pos) {
+                        r[ipos+d] = p.pos(d);
+                    }
+                    if (with_vel) {
+                        r[ivel+d] = p.rdata(d);
+                    }
+                }
+
+                constexpr int ni = 2;
+                constexpr int nj = AMREX_SPACEDIM >= 2 ? 2 : 1;
+                constexpr int nk = AMREX_SPACEDIM == 3 ? 2 : 1;
+
+                for (int m = 0; m < M; ++m) {
+                    Real val = 0.0_rt;
+                    for (int kk = 0; kk < nk; ++kk) {
+                        for (int jj = 0; jj < nj; ++jj) {
+                            for (int ii = 0; ii < ni; ++ii) {
+                                val += w[0][ii] * w[1][jj] * w[2][kk] *
+                                       data(i0[0]+ii, i0[1]+jj, i0[2]+kk, idx[m]);
+                            }
+                        }
+                    }
+                    r[ival+m] = val;
+                }
+
+                // A particle whose cell is outside this box is only written if
+                // it is in some other box of the level; flag it with a negative
+                // cpu so the host can make that check.
+
+                const bool inside = bx.contains(IntVect(AMREX_D_DECL(iv[0], iv[1], iv[2])));
+
+                pid[2*n  ] = p.id();
+                pid[2*n+1] = inside ? static_cast<Long>(p.cpu()) : -1 - static_cast<Long>(p.cpu());
+            });
+
+            h_rec.resize(d_rec.size());
+            h_id.resize(d_id.size());
+            h_cell.resize(d_cell.size());
+
+            Gpu::copyAsync(Gpu::deviceToHost, d_rec.begin(), d_rec.end(), h_rec.begin());
+            Gpu::copyAsync(Gpu::deviceToHost, d_id.begin(), d_id.end(), h_id.begin());
+            Gpu::copyAsync(Gpu::deviceToHost, d_cell.begin(), d_cell.end(), h_cell.begin());
+            Gpu::streamSynchronize();
+
+            for (int n = 0; n < np; ++n)
+            {
+                const Long id = h_id[2*n];
+                Long cpu = h_id[2*n+1];
+
+                if (id <= 0) continue;
+
+                if (cpu < 0) {
+                    cpu = -1 - cpu;
+                    const int* c = &h_cell[AMREX_SPACEDIM*n];
+                    if (!ba.contains(IntVect(AMREX_D_DECL(c[0], c[1], c[2])))) continue;
+                }
+
+                ids.push_back(id);
+                ids.push_back(cpu);
+                recs.insert(recs.end(), h_rec.begin() + static_cast<Long>(n) * nrec,
+                            h_rec.begin() + static_cast<Long>(n + 1) * nrec);
+            }
+        }
+    }
+
+    //
+    // Write the timestamp records of the particles at level lev as
+    // text.  The file layout is the same as that of
+    // TracerParticleContainer::Timestamp.
+    //
+    void write_timestamp (AmrTracerParticleContainer& pc,
+                          const std::string&          basename,
+                          const MultiFab&             mf,
+                          int                         lev,
+                          Real                        time,
+                          const std::vector<int>&     indices)
+    {
+        BL_PROFILE("Castro::write_timestamp()");
+
+        const int MyProc = ParallelDescriptor::MyProc();
+        const int NProcs = ParallelDescriptor::NProcs();
+
+        // We spread the output over this many files.
+        int nOutFiles = 64;
+        ParmParse pp("particles");
+        pp.query("particles_nfiles", nOutFiles);
+        if (nOutFiles == -1) {
+            nOutFiles = NProcs;
+        }
+        nOutFiles = std::max(1, std::min(nOutFiles, NProcs));
+        const int nSets = (NProcs + (nOutFiles - 1)) / nOutFiles;
+        const int mySet = MyProc / nOutFiles;
+
+        const int M = static_cast<int>(indices.size());
+        const int nrec = 2 * AMREX_SPACEDIM + M;
+
+        // Gather the records before taking our turn at the file, so the
+        // interpolation is not serialized with the I/O.
+
+        std::vector<std::int64_t> ids;
+        std::vector<double> recs;
+        gather_timestamp_records(pc, mf, lev, indices, true, true, ids, recs);
+
+        const auto nparticles = static_cast<Long>(ids.size()) / 2;
+
+        for (int iSet = 0; iSet < nSets; ++iSet)
+        {
+            if (mySet == iSet)
+            {
+                if (nparticles > 0)
+                {
+                    std::string FileName = amrex::Concatenate(basename + '_', MyProc % nOutFiles, 2);
+
+                    VisMF::IO_Buffer io_buffer(VisMF::IO_Buffer_Size);
+
+                    std::ofstream TimeStampFile;
+
+                    TimeStampFile.rdbuf()->pubsetbuf(io_buffer.dataPtr(), io_buffer.size());
+
+                    TimeStampFile.open(FileName.c_str(), std::ios::out|std::ios::app|std::ios::binary);
+
+                    TimeStampFile.setf(std::ios_base::scientific, std::ios_base::floatfield);
+
+                    TimeStampFile.precision(10);
+
+                    TimeStampFile.seekp(0, std::ios::end);
+
+                    if (!TimeStampFile.good()) {
+                        amrex::FileOpenFailed(FileName);
+                    }
+
+                    for (Long n = 0; n < nparticles; ++n)
+                    {
+                        const double* r = recs.data() + n * nrec;
+
+                        TimeStampFile << ids[2*n] << ' ' << ids[2*n+1] << ' ';
+
+                        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                            TimeStampFile << r[d] << ' ';
+                        }
+
+                        TimeStampFile << time;
+
+                        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                            TimeStampFile << ' ' << r[AMREX_SPACEDIM+d];
+                        }
+
+                        for (int m = 0; m < M; ++m) {
+                            TimeStampFile << ' ' << r[2*AMREX_SPACEDIM+m];
+                        }
+
+                        TimeStampFile << '\n';
+                    }
+
+                    TimeStampFile.flush();
+                    TimeStampFile.close();
+                }
+
+                const int iBuff     = 0;
+                const int wakeUpPID = MyProc + nOutFiles;
+                const int tag       = MyProc % nOutFiles;
+
+                if (wakeUpPID < NProcs) {
+                    ParallelDescriptor::Send(&iBuff, 1, wakeUpPID, tag);
+                }
+            }
+
+            if (mySet == (iSet + 1))
+            {
+                // Next set waits.
+                int iBuff;
+                const int waitForPID = MyProc - nOutFiles;
+                const int tag        = MyProc % nOutFiles;
+                ParallelDescriptor::Recv(&iBuff, 1, waitForPID, tag);
+            }
+        }
+    }
 }
 
 void
@@ -65,6 +362,10 @@ Castro::ParticleCheckPoint(const std::string& dir)
     {
         if (TracerPC)
             TracerPC->Checkpoint(dir, chk_tracer_particle_file);
+
+        // Make sure the particle history is on disk up to this point.
+        if (particle_history)
+            particle_history->flush();
     }
 }
 
@@ -210,8 +511,15 @@ Castro::TimestampParticles (int ngrow)
             std::cout << "Temp = " << UTEMP << std::endl;
         }
 
-        if (!timestamp_indices.empty()) {
-            imax = *(std::max_element(timestamp_indices.begin(), timestamp_indices.end()));
+        if (particles::timestamp_format == 1) {
+            setup_particle_history();
+        }
+
+        for (int n : timestamp_indices) {
+            imax = std::max(imax, n);
+        }
+        for (int n : history_indices) {
+            imax = std::max(imax, n);
         }
     }
 
@@ -226,21 +534,185 @@ Castro::TimestampParticles (int ngrow)
         int finest_level = parent->finestLevel();
         Real time        = state[State_Type].curTime();
 
+        if (particle_history) {
+            particle_history->set_step(parent->levelSteps(0));
+        }
+
+        std::vector<std::int64_t> ids;
+        std::vector<double> recs;
+
         for (int lev = level; lev <= finest_level; lev++)
         {
             if (TracerPC->NumberOfParticlesAtLevel(lev) <= 0) continue;
 
             MultiFab& S_new = parent->getLevel(lev).get_new_data(State_Type);
 
+            std::unique_ptr<FillPatchIterator> fpi;
+
             if (imax >= 0) {  // FillPatchIterator will fail otherwise
                 int ng = (lev == level) ? ngrow : 1;
-                FillPatchIterator fpi(parent->getLevel(lev), S_new,
-                                      ng, time, State_Type, 0, imax+1);
-                const MultiFab& S = fpi.get_mf();
-                TracerPC->Timestamp(basename, S    , lev, time, timestamp_indices);
+                fpi = std::make_unique<FillPatchIterator>(parent->getLevel(lev), S_new,
+                                                          ng, time, State_Type, 0, imax+1);
+            }
+
+            const MultiFab& S = fpi ? fpi->get_mf() : S_new;
+
+            if (particle_history) {
+                gather_timestamp_records(*TracerPC, S, lev, history_indices,
+                                         history_position, history_velocity, ids, recs);
+                particle_history->add_block(parent->levelSteps(0), lev, time, ids, recs);
             } else {
-                TracerPC->Timestamp(basename, S_new, lev, time, timestamp_indices);
+                write_timestamp(*TracerPC, basename, S, lev, time, timestamp_indices);
+            }
+        }
+    }
+}
+
+void
+Castro::setup_particle_history ()
+{
+    // The columns are always ordered as the position, the velocity, and
+    // then the state variables in the order they were listed.
+
+    std::vector<std::string> vars;
+
+    if (particles::timestamp_vars.empty()) {
+        vars = {"position", "velocity"};
+        if (particles::timestamp_density) {
+            vars.emplace_back(desc_lst[State_Type].name(URHO));
+        }
+        if (particles::timestamp_temperature) {
+            vars.emplace_back(desc_lst[State_Type].name(UTEMP));
+        }
+    } else {
+        std::istringstream is(particles::timestamp_vars);
+        std::string var;
+        while (is >> var) {
+            vars.push_back(var);
+        }
+    }
+
+    history_position = false;
+    history_velocity = false;
+    history_indices.clear();
+
+    std::vector<std::string> state_columns;
+
+    for (const auto& var : vars) {
+        if (var == "position") {
+            history_position = true;
+        } else if (var == "velocity") {
+            history_velocity = true;
+        } else {
+            int icomp = -1;
+            for (int n = 0; n < desc_lst[State_Type].nComp(); ++n) {
+                if (desc_lst[State_Type].name(n) == var) {
+                    icomp = n;
+                    break;
+                }
+            }
+            if (icomp < 0) {
+                amrex::Error("particles.timestamp_vars: " + var + " is not a state variable");
             }
+            history_indices.push_back(icomp);
+            state_columns.push_back(var);
+        }
+    }
+
+    const std::vector<std::string> pos_names = {AMREX_D_DECL("x", "y", "z")};
+    const std::vector<std::string> vel_names = {AMREX_D_DECL("vx", "vy", "vz")};
+
+    std::vector<std::string> columns;
+    if (history_position) {
+        columns.insert(columns.end(), pos_names.begin(), pos_names.end());
+    }
+    if (history_velocity) {
+        columns.insert(columns.end(), vel_names.begin(), vel_names.end());
+    }
+    columns.insert(columns.end(), state_columns.begin(), state_columns.end());
+
+    int nfiles = 64;
+    ParmParse pp("particles");
+    pp.query("particles_nfiles", nfiles);
+
+    particle_history = std::make_unique<ParticleHistory>(particles::timestamp_dir, columns, nfiles,
+                                                         particles::history_interval,
+                                                         static_cast<std::size_t>(particles::history_buffer_size) * 1024 * 1024);
+}
+
+void
+Castro::sort_tracer_particles ()
+{
+    BL_PROFILE("Castro::sort_tracer_particles()");
+
+    if (!TracerPC) return;
+
+    for (int lev = level; lev <= parent->finestLevel(); ++lev)
+    {
+        if (TracerPC->NumberOfParticlesAtLevel(lev) <= 0) continue;
+
+        const auto plo = TracerPC->Geom(lev).ProbLoArray();
+        const auto dxi = TracerPC->Geom(lev).InvCellSizeArray();
+
+        for (TracerParIter pti(*TracerPC, lev); pti.isValid(); ++pti)
+        {
+            const int np = pti.numParticles();
+            if (np < 2) continue;
+
+            const auto lo = amrex::lbound(pti.tilebox());
+            const auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+
+            // Morton key of each particle's cell, relative to the tile.
+
+            Gpu::DeviceVector<std::uint64_t> d_keys(np);
+            std::uint64_t* keys = d_keys.dataPtr();
+
+            amrex::ParallelFor(np,
+            [=] AMREX_GPU_DEVICE (int n) noexcept
+            {
+                const auto& p = pstruct[n];
+
+                int iv[3] = {0, 0, 0};
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    iv[d] = static_cast<int>(amrex::Math::floor((p.pos(d) - plo[d]) * dxi[d]));
+                }
+
+                const auto i = static_cast<std::uint64_t>(amrex::max(iv[0] - lo.x, 0));
+                const auto j = static_cast<std::uint64_t>(amrex::max(iv[1] - lo.y, 0));
+                const auto k = static_cast<std::uint64_t>(amrex::max(iv[2] - lo.z, 0));
+
+#if AMREX_SPACEDIM == 1
+                amrex::ignore_unused(j, k);
+                keys[n] = i;
+#elif AMREX_SPACEDIM == 2
+                amrex::ignore_unused(k);
+                keys[n] = morton_spread(i) | (morton_spread(j) << 1);
+#else
+                keys[n] = morton_spread(i) | (morton_spread(j) << 1) | (morton_spread(k) << 2);
+#endif
+            });
+
+            // The permutation (new index -> old index) is built on the host;
+            // the sort is only done every particles::sort_interval steps.
+
+            Vector<std::uint64_t> h_keys(np);
+            Gpu::copyAsync(Gpu::deviceToHost, d_keys.begin(), d_keys.end(), h_keys.begin());
+            Gpu::streamSynchronize();
+
+            if (std::is_sorted(h_keys.begin(), h_keys.end())) continue;
+
+            Vector<unsigned int> h_perm(np);
+            std::iota(h_perm.begin(), h_perm.end(), 0U);
+
+            std::stable_sort(h_perm.begin(), h_perm.end(),
+                             [&] (unsigned int a, unsigned int b) { return h_keys[a] < h_keys[b]; });
+
+            Gpu::DeviceVector<unsigned int> d_perm(np);
+            Gpu::copyAsync(Gpu::hostToDevice, h_perm.begin(), h_perm.end(), d_perm.begin());
+
+            TracerPC->ReorderParticles(lev, pti, d_perm.dataPtr());
+
+            Gpu::streamSynchronize();
         }
     }
 }
@@ -255,26 +727,54 @@ Castro::advance_particles(int iteration, Real time, Real dt)
         int ng = iteration;
         Real t = time + 0.5*dt;
 
+        Real strt_time = ParallelDescriptor::second();
+
         MultiFab Ucc(grids,dmap,AMREX_SPACEDIM,ng); // cell centered velocity
 
         {
             FillPatchIterator fpi(*this, Ucc, ng, t, State_Type, 0, AMREX_SPACEDIM+1);
-            MultiFab& S = fpi.get_mf();
+            const MultiFab& S = fpi.get_mf();
 
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-            for (MFIter mfi(Ucc,true); mfi.isValid(); ++mfi)
+            for (MFIter mfi(Ucc, TilingIfNotGPU()); mfi.isValid(); ++mfi)
             {
                 const Box& bx = mfi.growntilebox();
-                S[mfi].invert(1.0, bx, 0, 1);
-                for (int dir=0; dir < AMREX_SPACEDIM; ++dir) {
-                    Ucc[mfi].copy(S[mfi], bx, dir+1, bx, dir, 1);
-                    Ucc[mfi].mult(S[mfi], bx, 0, dir);
-                }
+
+                auto s = S.const_array(mfi);
+                auto u = Ucc.array(mfi);
+
+                // The density is component 0 and the momenta follow it.
+
+                amrex::ParallelFor(bx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    const Real rhoInv = 1.0_rt / s(i,j,k,0);
+                    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+                        u(i,j,k,dir) = s(i,j,k,dir+1) * rhoInv;
+                    }
+                });
             }
         }
 
         TracerPC->AdvectWithUcc(Ucc, level, dt);
+
+        if (verbose)
+        {
+            const int IOProc = ParallelDescriptor::IOProcessorNumber();
+            Real run_time = ParallelDescriptor::second() - strt_time;
+
+#ifdef BL_LAZY
+            Lazy::QueueReduction( [=] () mutable {
+#endif
+            ParallelDescriptor::ReduceRealMax(run_time, IOProc);
+            if (ParallelDescriptor::IOProcessor()) {
+                std::cout << "Castro::advance_particles() at level " << level << " : time = " << run_time << std::endl;
+            }
+#ifdef BL_LAZY
+            });
+#endif
+        }
     }
 }
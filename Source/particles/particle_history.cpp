@@ -0,0 +1,328 @@
+#include <particle_history.H>
+
+#include <AMReX.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <utility>
+
+using namespace amrex;
+
+namespace {
+    const char magic[8] = {'C', 'A', 'S', 'T', 'R', 'O', 'P', 'H'};
+    const std::uint32_t byte_order_mark = 0x01020304;
+
+    // number of integers in an index entry:
+    // block, step, level, rank, file, offset, nrec
+    constexpr int n_index = 7;
+
+    template <typename T>
+    void append_bytes (std::vector<char>& buf, const T& value)
+    {
+        const char* p = reinterpret_cast<const char*>(&value);
+        buf.insert(buf.end(), p, p + sizeof(T));
+    }
+
+    template <typename T>
+    void read_bytes (std::istream& is, T& value)
+    {
+        is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+}
+
+ParticleHistory::ParticleHistory (std::string dir,
+                                  std::vector<std::string> columns,
+                                  int nfiles,
+                                  int interval,
+                                  std::size_t buffer_bytes)
+    : m_dir(std::move(dir)),
+      m_columns(std::move(columns)),
+      m_interval(interval),
+      m_buffer_bytes(buffer_bytes)
+{
+    const int NProcs = ParallelDescriptor::NProcs();
+
+    if (nfiles == -1) {
+        nfiles = NProcs;
+    }
+    m_nfiles = std::max(1, std::min(nfiles, NProcs));
+
+    if (!m_dir.empty() && m_dir.back() != '/') {
+        m_dir += '/';
+    }
+
+    m_buffer.reserve(m_buffer_bytes);
+}
+
+void
+ParticleHistory::set_step (int step)
+{
+    const int start = (m_interval > 0) ? (step / m_interval) * m_interval : 0;
+
+    if (m_basename.empty() || start != m_interval_start) {
+        flush();
+
+        m_interval_start = start;
+
+        if (m_interval > 0) {
+            m_basename = amrex::Concatenate(m_dir + "History_", start, 7);
+        } else {
+            m_basename = m_dir + "History";
+        }
+    }
+}
+
+void
+ParticleHistory::add_block (int step, int level, Real time,
+                            const std::vector<std::int64_t>& ids,
+                            const std::vector<double>& values)
+{
+    const auto ncol = m_columns.size();
+    const auto nrec = static_cast<std::int64_t>(ids.size() / 2);
+
+    AMREX_ALWAYS_ASSERT(values.size() == static_cast<std::size_t>(nrec) * ncol);
+
+    Block b;
+    b.step = step;
+    b.level = level;
+    b.time = static_cast<double>(time);
+    b.nrec = nrec;
+    b.offset = static_cast<std::int64_t>(m_buffer.size());
+
+    m_blocks.push_back(b);
+
+    append_bytes(m_buffer, b.step);
+    append_bytes(m_buffer, b.level);
+    append_bytes(m_buffer, b.time);
+    append_bytes(m_buffer, b.nrec);
+
+    const std::size_t start = m_buffer.size();
+    m_buffer.resize(start + nrec * record_bytes());
+
+    char* p = m_buffer.data() + start;
+    for (std::int64_t n = 0; n < nrec; ++n) {
+        std::memcpy(p, &ids[2*n], 2 * sizeof(std::int64_t));
+        p += 2 * sizeof(std::int64_t);
+        std::memcpy(p, &values[n * ncol], ncol * sizeof(double));
+        p += ncol * sizeof(double);
+    }
+
+    bool full = m_buffer.size() >= m_buffer_bytes;
+    ParallelDescriptor::ReduceBoolOr(full);
+
+    if (full) {
+        flush();
+    }
+}
+
+std::int64_t
+ParticleHistory::prepare_file (const std::string& filename) const
+{
+    // If the file already has data, check that it has our columns and
+    // return its size; otherwise write the header and return its size.
+
+    {
+        std::ifstream ifs(filename, std::ios::in | std::ios::binary | std::ios::ate);
+
+        if (ifs.good() && ifs.tellg() > 0) {
+            const auto size = static_cast<std::int64_t>(ifs.tellg());
+            ifs.seekg(0);
+
+            char m[8];
+            std::uint32_t bom = 0, vers = 0, ncol = 0, rbytes = 0;
+            ifs.read(m, 8);
+            read_bytes(ifs, bom);
+            read_bytes(ifs, vers);
+            read_bytes(ifs, ncol);
+            read_bytes(ifs, rbytes);
+
+            bool match = ifs.good() && std::memcmp(m, magic, 8) == 0 &&
+                         bom == byte_order_mark && vers == version &&
+                         ncol == m_columns.size() && rbytes == record_bytes();
+
+            for (std::uint32_t n = 0; match && n < ncol; ++n) {
+                std::uint32_t len = 0;
+                read_bytes(ifs, len);
+                std::string name(len, ' ');
+                ifs.read(name.data(), len);
+                match = ifs.good() && name == m_columns[n];
+            }
+
+            if (!match) {
+                amrex::Abort("ParticleHistory: the columns of " + filename + " do not match particles.timestamp_vars");
+            }
+
+            return size;
+        }
+    }
+
+    std::vector<char> header;
+    header.insert(header.end(), magic, magic + 8);
+    append_bytes(header, byte_order_mark);
+    append_bytes(header, version);
+    append_bytes(header, static_cast<std::uint32_t>(m_columns.size()));
+    append_bytes(header, static_cast<std::uint32_t>(record_bytes()));
+    for (const auto& name : m_columns) {
+        append_bytes(header, static_cast<std::uint32_t>(name.size()));
+        header.insert(header.end(), name.begin(), name.end());
+    }
+
+    std::ofstream ofs(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs.good()) {
+        amrex::FileOpenFailed(filename);
+    }
+    ofs.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    return static_cast<std::int64_t>(header.size());
+}
+
+void
+ParticleHistory::flush ()
+{
+    // The blocks are added collectively, so every rank agrees on this.
+    if (m_blocks.empty()) return;
+
+    BL_PROFILE("ParticleHistory::flush()");
+
+    const int MyProc = ParallelDescriptor::MyProc();
+    const int NProcs = ParallelDescriptor::NProcs();
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+
+    const int nSets  = (NProcs + (m_nfiles - 1)) / m_nfiles;
+    const int mySet  = MyProc / m_nfiles;
+    const int fileno = MyProc % m_nfiles;
+
+    std::int64_t nrec_total = 0;
+    for (const auto& b : m_blocks) {
+        nrec_total += b.nrec;
+    }
+
+    // The ranks sharing a file take turns appending to it.
+
+    std::int64_t file_offset = 0;
+
+    for (int iSet = 0; iSet < nSets; ++iSet)
+    {
+        if (mySet == iSet)
+        {
+            if (nrec_total > 0)
+            {
+                const std::string filename = amrex::Concatenate(m_basename + '_', fileno, 2);
+
+                file_offset = prepare_file(filename);
+
+                std::ofstream ofs(filename, std::ios::out | std::ios::binary | std::ios::app);
+                if (!ofs.good()) {
+                    amrex::FileOpenFailed(filename);
+                }
+                ofs.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+                ofs.close();
+
+                if (!ofs.good()) {
+                    amrex::Abort("ParticleHistory: error writing " + filename);
+                }
+            }
+
+            const int iBuff     = 0;
+            const int wakeUpPID = MyProc + m_nfiles;
+            const int tag       = MyProc % m_nfiles;
+
+            if (wakeUpPID < NProcs) {
+                ParallelDescriptor::Send(&iBuff, 1, wakeUpPID, tag);
+            }
+        }
+
+        if (mySet == (iSet + 1))
+        {
+            // Next set waits.
+            int iBuff;
+            const int waitForPID = MyProc - m_nfiles;
+            const int tag        = MyProc % m_nfiles;
+            ParallelDescriptor::Recv(&iBuff, 1, waitForPID, tag);
+        }
+    }
+
+    // Gather the index entries of the non-empty blocks on the I/O processor.
+
+    std::vector<Long> entries;
+    std::vector<Real> times;
+
+    for (int ib = 0; ib < static_cast<int>(m_blocks.size()); ++ib) {
+        const auto& b = m_blocks[ib];
+        if (b.nrec == 0) continue;
+        entries.insert(entries.end(), {static_cast<Long>(ib), b.step, b.level, static_cast<Long>(MyProc),
+                                       static_cast<Long>(fileno), file_offset + b.offset, b.nrec});
+        times.push_back(static_cast<Real>(b.time));
+    }
+
+    int nentries = static_cast<int>(times.size());
+
+    std::vector<int> counts(NProcs, 0);
+    ParallelDescriptor::Gather(&nentries, 1, counts.data(), 1, IOProc);
+
+    std::vector<int> time_counts(NProcs, 0), time_disp(NProcs, 0);
+    std::vector<int> entry_counts(NProcs, 0), entry_disp(NProcs, 0);
+
+    if (ParallelDescriptor::IOProcessor()) {
+        for (int p = 0; p < NProcs; ++p) {
+            time_counts[p] = counts[p];
+            entry_counts[p] = n_index * counts[p];
+        }
+        std::partial_sum(time_counts.begin(), time_counts.end() - 1, time_disp.begin() + 1);
+        std::partial_sum(entry_counts.begin(), entry_counts.end() - 1, entry_disp.begin() + 1);
+    }
+
+    const int ntotal = std::accumulate(counts.begin(), counts.end(), 0);
+
+    std::vector<Long> all_entries(ParallelDescriptor::IOProcessor() ? n_index * ntotal : 0);
+    std::vector<Real> all_times(ParallelDescriptor::IOProcessor() ? ntotal : 0);
+
+    ParallelDescriptor::Gatherv(entries.data(), n_index * nentries,
+                                all_entries.data(), entry_counts, entry_disp, IOProc);
+    ParallelDescriptor::Gatherv(times.data(), nentries,
+                                all_times.data(), time_counts, time_disp, IOProc);
+
+    if (ParallelDescriptor::IOProcessor() && ntotal > 0)
+    {
+        // Order the entries by block, then by rank.
+
+        std::vector<int> order(ntotal);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&] (int a, int b) { return all_entries[n_index * a] < all_entries[n_index * b]; });
+
+        const std::string index_name = m_basename + ".idx";
+
+        bool new_file = false;
+        {
+            std::ifstream ifs(index_name);
+            new_file = !ifs.good() || ifs.peek() == std::ifstream::traits_type::eof();
+        }
+
+        std::ofstream index(index_name, std::ios::out | std::ios::app);
+        if (!index.good()) {
+            amrex::FileOpenFailed(index_name);
+        }
+
+        if (new_file) {
+            index << "# step level time rank file offset nrecords" << std::endl;
+        }
+
+        index << std::setprecision(17);
+
+        for (int n : order) {
+            const Long* e = &all_entries[n_index * n];
+            index << e[1] << " " << e[2] << " " << all_times[n] << " "
+                  << e[3] << " " << e[4] << " " << e[5] << " " << e[6] << "\n";
+        }
+    }
+
+    m_blocks.clear();
+    m_buffer.clear();
+}
@@ -164,9 +164,14 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
   FluxRegister* flux_in = (level < fine_level) ? flux_trial[level+1].get() : nullptr;
   FluxRegister* flux_out = (level > 0) ? flux_trial[level].get() : nullptr;
 
+  // With MLMG, all of the groups are solved at once, so the fluxes
+  // hold every group.
+
+  const int nflux = RadSolve::use_mlmg() ? nGroups : 1;
+
   Array<MultiFab, AMREX_SPACEDIM> Flux;
   for (int n = 0; n < AMREX_SPACEDIM; n++) {
-      Flux[n].define(castro->getEdgeBoxArray(n), dmap, 1, 0);
+      Flux[n].define(castro->getEdgeBoxArray(n), dmap, nflux, 0);
   }
 
   std::unique_ptr<MultiFab> flxsave;
@@ -256,44 +261,95 @@ void Radiation::MGFLD_implicit_update(int level, int iteration, int ncycle)
 
       compute_coupling(coupT, kappa_p, Er_pi, jg);
 
-      for (int igroup=0; igroup<nGroups; ++igroup) {
+      if (RadSolve::use_mlmg()) {
 
-        set_current_group(igroup);
+        // Within an inner iteration the groups are only coupled
+        // through the lagged quantities, so we can set up the system
+        // for every group and do a single multi-component solve.
 
-        // setup and solve linear system
+        MultiFab acoefs(grids, dmap, nGroups, 0);
+        Array<MultiFab, AMREX_SPACEDIM> bcoefs;
+        for (int n = 0; n < AMREX_SPACEDIM; n++) {
+            bcoefs[n].define(castro->getEdgeBoxArray(n), dmap, nGroups, 0);
+        }
+        MultiFab rhs(grids, dmap, nGroups, 0);
 
-        // set boundary condition
-        solver->levelBndry(mgbd, igroup);
-        
-        solver->levelACoeffs(level, kappa_p, delta_t, c, igroup, ptc_tau);
+        for (int igroup=0; igroup<nGroups; ++igroup) {
 
-        int lamcomp = (radiation::limiter==0) ? 0 : igroup;
-        solver->levelBCoeffs(level, lambda, kappa_r, igroup, c, lamcomp);
+          set_current_group(igroup);
 
-        if (have_Sanchez_Pomraning) {
-          solver->levelSPas(level, lambda, igroup, lo_bc, hi_bc);
-        }
+          MultiFab acoefs_g(acoefs, amrex::make_alias, igroup, 1);
+          solver->computeACoeffs(level, acoefs_g, kappa_p, delta_t, c, igroup, ptc_tau);
 
-        { // src and rhd block
-                  
-          MultiFab rhs(grids,dmap,1,0);
+          int lamcomp = (radiation::limiter==0) ? 0 : igroup;
+          for (int n = 0; n < AMREX_SPACEDIM; n++) {
+            MultiFab bcoefs_g(bcoefs[n], amrex::make_alias, igroup, 1);
+            solver->computeBCoeffs(bcoefs_g, n, kappa_r, igroup, lambda[n], lamcomp, c, parent->Geom(level));
+          }
 
-          solver->levelRhs(level, rhs, jg, mugT,
+          MultiFab rhs_g(rhs, amrex::make_alias, igroup, 1);
+          solver->levelRhs(level, rhs_g, jg, mugT,
                            coupT, etaT,
                            Er_step, rhoe_step, Er_star, rhoe_star,
                            delta_t, igroup, it, ptc_tau);
+        }
+
+        solver->levelSolveMLMG(level, Er_new, rhs, acoefs, bcoefs, mgbd, rad_bc, time, Flux);
+
+        for (int igroup=0; igroup<nGroups; ++igroup) {
+
+          Array<MultiFab, AMREX_SPACEDIM> Flux_g{AMREX_D_DECL(MultiFab(Flux[0], amrex::make_alias, igroup, 1),
+                                                              MultiFab(Flux[1], amrex::make_alias, igroup, 1),
+                                                              MultiFab(Flux[2], amrex::make_alias, igroup, 1))};
+
+          solver->levelFluxReg(level, flux_in, flux_out, Flux_g, igroup);
+
+          if (icomp_flux >= 0)
+              solver->levelFluxFaceToCenter(level, Flux_g, *flxcc, icomp_flux+igroup);
+        }
 
-          // solve Er equation and put solution in Er_new(igroup)
-          solver->levelSolve(level, Er_new, igroup, rhs, 0.01);
-        } // end src and rhs block
+      }
+      else {
+
+        for (int igroup=0; igroup<nGroups; ++igroup) {
+
+          set_current_group(igroup);
+
+          // setup and solve linear system
+
+          // set boundary condition
+          solver->levelBndry(mgbd, igroup);
+        
+          solver->levelACoeffs(level, kappa_p, delta_t, c, igroup, ptc_tau);
+
+          int lamcomp = (radiation::limiter==0) ? 0 : igroup;
+          solver->levelBCoeffs(level, lambda, kappa_r, igroup, c, lamcomp);
 
-        solver->levelFlux(level, Flux, Er_new, igroup);
-        solver->levelFluxReg(level, flux_in, flux_out, Flux, igroup);
+          if (have_Sanchez_Pomraning) {
+            solver->levelSPas(level, lambda, igroup, lo_bc, hi_bc);
+          }
+
+          { // src and rhd block
+                  
+            MultiFab rhs(grids,dmap,1,0);
+
+            solver->levelRhs(level, rhs, jg, mugT,
+                             coupT, etaT,
+                             Er_step, rhoe_step, Er_star, rhoe_star,
+                             delta_t, igroup, it, ptc_tau);
+
+            // solve Er equation and put solution in Er_new(igroup)
+            solver->levelSolve(level, Er_new, igroup, rhs, 0.01);
+          } // end src and rhs block
+
+          solver->levelFlux(level, Flux, Er_new, igroup);
+          solver->levelFluxReg(level, flux_in, flux_out, Flux, igroup);
           
-        if (icomp_flux >= 0) 
-            solver->levelFluxFaceToCenter(level, Flux, *flxcc, icomp_flux+igroup);
+          if (icomp_flux >= 0) 
+              solver->levelFluxFaceToCenter(level, Flux, *flxcc, icomp_flux+igroup);
 
-      } // end loop over groups
+        } // end loop over groups
+      }
       
       // Check for convergence *before* acceleration step:
       check_convergence_er(relative_in, absolute_in, error_er, Er_new, Er_pi,
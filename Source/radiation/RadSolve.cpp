@@ -2,6 +2,8 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_AmrLevel.H>
 #include <AMReX_LO_BCTYPES.H>
+#include <AMReX_MLABecLaplacian.H>
+#include <AMReX_MLMG.H>
 
 #include <RadSolve.H>
 #include <Radiation.H>  // for access to static physical constants only
@@ -21,7 +23,10 @@ RadSolve::RadSolve (Amr* Parent, int level, const BoxArray& grids, const Distrib
 {
     read_params();
 
-    if (radsolve::level_solver_flag < 100) {
+    if (use_mlmg()) {
+        // The MLMG operator is built for each solve in levelSolveMLMG.
+    }
+    else if (radsolve::level_solver_flag < 100) {
         hd.reset(new HypreABec(grids, dmap, parent->Geom(level), radsolve::level_solver_flag));
     }
     else {
@@ -57,6 +62,16 @@ RadSolve::read_params ()
 
     // Check for unsupported options.
 
+    if (use_mlmg()) {
+        if (Radiation::SolverType != Radiation::MGFLDSolver) {
+            amrex::Error("radsolve.level_solver_flag = 200 is only supported by the MGFLD solver");
+        }
+
+        if (Radiation::accelerate == 2 && Radiation::nGroups > 1) {
+            amrex::Error("radsolve.level_solver_flag = 200 does not support radiation.accelerate = 2");
+        }
+    }
+
     if (AMREX_SPACEDIM == 1) {
         if (radsolve::level_solver_flag == 1) {
             amrex::Error("radsolve.level_solver_flag = 1 is not supported in 1D");
@@ -328,6 +343,153 @@ void RadSolve::levelSPas(int level, Array<MultiFab, AMREX_SPACEDIM>& lambda, int
   }
 }
 
+void RadSolve::levelSolveMLMG(int level, MultiFab& Er, MultiFab& rhs,
+                              const MultiFab& acoefs,
+                              const Array<MultiFab, AMREX_SPACEDIM>& bcoefs,
+                              const MGRadBndry& mgbd, const BCRec& rad_bc,
+                              Real time,
+                              Array<MultiFab, AMREX_SPACEDIM>& Flux)
+{
+  BL_PROFILE("RadSolve::levelSolveMLMG");
+
+  const int ncomp = rhs.nComp();
+
+  const Geometry& geom = parent->Geom(level);
+  const BoxArray& grids = rhs.boxArray();
+  const DistributionMapping& dmap = rhs.DistributionMap();
+
+  // The coefficients and the right hand side already include the
+  // metric terms (as they do for Hypre), so the operator itself
+  // needs to be Cartesian.
+
+  LPInfo info;
+  info.setMetricTerm(false);
+
+  MLABecLaplacian mlabec({geom}, {grids}, {dmap}, info, {}, ncomp);
+
+  // Use the same linear boundary stencil as the Hypre solvers.
+
+  mlabec.setMaxOrder(2);
+
+  Array<LinOpBCType, AMREX_SPACEDIM> lobc;
+  Array<LinOpBCType, AMREX_SPACEDIM> hibc;
+
+  for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+      for (int side = 0; side < 2; ++side) {
+          const int bct = (side == 0) ? rad_bc.lo(idim) : rad_bc.hi(idim);
+          LinOpBCType& mlmg_bc = (side == 0) ? lobc[idim] : hibc[idim];
+
+          if (geom.isPeriodic(idim)) {
+              mlmg_bc = LinOpBCType::Periodic;
+          }
+          else if (bct == AMREX_LO_DIRICHLET) {
+              mlmg_bc = LinOpBCType::Dirichlet;
+          }
+          else if (bct == AMREX_LO_NEUMANN) {
+              mlmg_bc = LinOpBCType::Neumann;
+          }
+          else {
+              amrex::Error("radsolve.level_solver_flag = 200 only supports Dirichlet, Neumann, and periodic boundaries");
+          }
+      }
+  }
+
+  mlabec.setDomainBC(lobc, hibc);
+
+  // MLMG's Neumann boundaries are homogeneous, whereas the Hypre solvers
+  // add a nonzero Neumann value as a boundary flux, so make sure that
+  // none is set.
+
+  Real neumann_bcval = 0.0;
+
+  for (OrientationIter face; face; ++face) {
+      const int idim = face().coordDir();
+      const int bct = face().isLow() ? rad_bc.lo(idim) : rad_bc.hi(idim);
+
+      if (geom.isPeriodic(idim) || bct != AMREX_LO_NEUMANN) {
+          continue;
+      }
+
+      const Box domain_face = amrex::adjCell(geom.Domain(), face());
+      const FabSet& bndry_values = mgbd.bndryValues(face());
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(max:neumann_bcval)
+#endif
+      for (FabSetIter fsi(bndry_values); fsi.isValid(); ++fsi) {
+          const Box bx = bndry_values[fsi].box() & domain_face;
+          if (bx.ok()) {
+              for (int n = 0; n < ncomp; ++n) {
+                  neumann_bcval = amrex::max(neumann_bcval,
+                                             bndry_values[fsi].maxabs<RunOn::Device>(bx, n));
+              }
+          }
+      }
+  }
+
+  ParallelDescriptor::ReduceRealMax(neumann_bcval);
+
+  if (neumann_bcval > 0.0) {
+      amrex::Error("radsolve.level_solver_flag = 200 only supports homogeneous Neumann boundaries");
+  }
+
+  // We solve on a copy of Er with a ghost cell, which holds the
+  // Dirichlet values on the physical boundaries.
+
+  MultiFab sol(grids, dmap, ncomp, 1);
+  sol.setVal(0.0);
+  MultiFab::Copy(sol, Er, 0, 0, ncomp, 0);
+
+  for (OrientationIter face; face; ++face) {
+      const FabSet& bndry_values = mgbd.bndryValues(face());
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      for (MFIter mfi(sol); mfi.isValid(); ++mfi) {
+          const Box& bx = bndry_values[mfi].box() & sol[mfi].box();
+          if (bx.ok()) {
+              sol[mfi].copy<RunOn::Device>(bndry_values[mfi], bx, 0, bx, 0, ncomp);
+          }
+      }
+  }
+
+  // At coarse-fine boundaries MLMG interpolates the coarse Er itself.
+
+  MultiFab crse_Er;
+
+  if (level > 0) {
+      AmrLevel& crse_level = parent->getLevel(level-1);
+      crse_Er.define(crse_level.boxArray(), crse_level.DistributionMap(), ncomp, 1);
+      AmrLevel::FillPatch(crse_level, crse_Er, 1, time, Rad_Type, 0, ncomp);
+      mlabec.setCoarseFineBC(&crse_Er, parent->refRatio(level-1)[0]);
+  }
+
+  mlabec.setLevelBC(0, &sol);
+
+  mlabec.setScalars(radsolve::alpha, radsolve::beta);
+  mlabec.setACoeffs(0, acoefs);
+  mlabec.setBCoeffs(0, amrex::GetArrOfConstPtrs(bcoefs));
+
+  MLMG mlmg(mlabec);
+  mlmg.setVerbose(radsolve::verbose);
+  mlmg.setMaxIter(radsolve::maxiter);
+
+  const Real res = mlmg.solve({&sol}, {&rhs}, radsolve::reltol, radsolve::abstol);
+
+  if (radsolve::verbose >= 2 && ParallelDescriptor::IOProcessor()) {
+    int oldprec = std::cout.precision(20);
+    std::cout << "MLMG final residual = " << res << std::endl;
+    std::cout.precision(oldprec);
+  }
+
+  MultiFab::Copy(Er, sol, 0, 0, ncomp, 0);
+
+  // Unlike levelFlux, this already accounts for the boundary conditions.
+
+  mlmg.getFluxes({amrex::GetArrOfPtrs(Flux)}, {&sol}, MLLinOp::Location::FaceCenter);
+}
+
 void RadSolve::levelBCoeffs(int level,
                             Array<MultiFab, AMREX_SPACEDIM>& lambda,
                             MultiFab& kappa_r, int kcomp,
@@ -991,20 +1153,12 @@ void RadSolve::computeBCoeffs(MultiFab& bcoefs, int idim,
   }
 }
 
-void RadSolve::levelACoeffs(int level, MultiFab& kpp, 
-                            Real delta_t, Real c, int igroup, Real ptc_tau)
+void RadSolve::computeACoeffs(int level, MultiFab& acoefs, MultiFab& kpp,
+                              Real delta_t, Real c, int igroup, Real ptc_tau)
 {
-  BL_PROFILE("RadSolve::levelACoeffs (MGFLD)");
-  const BoxArray& grids = parent->boxArray(level);
-  const DistributionMapping& dmap = parent->DistributionMap(level);
+  BL_PROFILE("RadSolve::computeACoeffs (MGFLD)");
   const auto geomdata = parent->Geom(level).data();
 
-  // allocate space for ABecLaplacian acoeffs, fill with values
-
-  int Ncomp = 1;
-  int Nghost = 0;
-  MultiFab acoefs(grids, dmap, Ncomp, Nghost);
-
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -1027,6 +1181,22 @@ void RadSolve::levelACoeffs(int level, MultiFab& kpp,
           acoefs_arr(i,j,k) = r * s * acoefs_arr(i,j,k);
       });
   }
+}
+
+void RadSolve::levelACoeffs(int level, MultiFab& kpp,
+                            Real delta_t, Real c, int igroup, Real ptc_tau)
+{
+  BL_PROFILE("RadSolve::levelACoeffs (MGFLD)");
+  const BoxArray& grids = parent->boxArray(level);
+  const DistributionMapping& dmap = parent->DistributionMap(level);
+
+  // allocate space for ABecLaplacian acoeffs, fill with values
+
+  int Ncomp = 1;
+  int Nghost = 0;
+  MultiFab acoefs(grids, dmap, Ncomp, Nghost);
+
+  computeACoeffs(level, acoefs, kpp, delta_t, c, igroup, ptc_tau);
 
   // set a coefficients
   if (hd) {
@@ -9,6 +9,18 @@
 using std::string;
 using namespace amrex;
 
+namespace {
+    // A zone to be burned in the batched mode of react_state:
+    // the local index of its box, and its index in that box.
+
+    struct burn_zone_index {
+        int box;
+        int i;
+        int j;
+        int k;
+    };
+}
+
 #ifndef TRUE_SDC
 
 advance_status
@@ -154,6 +166,10 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
         // Ensure we always have valid data, even if we don't do the burn.
         r.setVal(0.0, r.nGrow());
 
+        if (burn_weights.isDefined()) {
+            burn_weights.setVal(0.0, strang_half, 1);
+        }
+
         return burn_success;
 
     }
@@ -165,6 +181,10 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
         // Ensure we always have valid data, even if we don't do the burn.
         r.setVal(0.0, r.nGrow());
 
+        if (burn_weights.isDefined()) {
+            burn_weights.setVal(0.0, strang_half, 1);
+        }
+
         return burn_success;
 
     }
@@ -186,244 +206,518 @@ Castro::react_state(MultiFab& s, MultiFab& r, Real time, Real dt, const int stra
     MultiFab tmp_mask_mf;
     const MultiFab& mask_mf = mask_covered_zones ? getLevel(level+1).build_fine_mask() : tmp_mask_mf;
 
-#if defined(AMREX_USE_GPU)
-    Gpu::Buffer<int> d_num_failed({0});
-    auto* p_num_failed = d_num_failed.data();
-#endif
-    int num_failed = 0;
+    // burn_weights is allocated if we are storing it in the plotfile
+    // or using it for load balancing
 
-#ifdef _OPENMP
-#pragma omp parallel reduction(+:num_failed)
-#endif
-    for (MFIter mfi(s, TilingIfNotGPU()); mfi.isValid(); ++mfi)
-    {
+    const bool record_weights = burn_weights.isDefined();
 
-        const Box& bx = mfi.growntilebox(ng);
+    // Keep track of which boxes failed, in case we do a local retry.
 
-        auto U = s.array(mfi);
-        auto reactions = r.array(mfi);
-        auto weights = store_burn_weights ? burn_weights.array(mfi) : Array4<Real>{};
-        const auto mask = mask_covered_zones ? mask_mf.array(mfi) : Array4<Real>{};
+    const int pass = retry_local_pass;
+    const bool record_failed_boxes = retry_local == 1 && pass == 0;
 
-        const auto dx = geom.CellSizeArray();
+    Gpu::DeviceVector<int> box_failed(record_failed_boxes ? s.size() : 0, 0);
+    int* p_box_failed = box_failed.data();
+
+    const auto dx = geom.CellSizeArray();
 #ifdef MODEL_PARSER
-        const auto problo = geom.ProbLoArray();
+    const auto problo = geom.ProbLoArray();
 #endif
 
-#if defined(AMREX_USE_GPU)
-        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-#else
-        LoopOnCpu(bx, [&] (int i, int j, int k) mutable
+    // Decide whether a zone should be burned.
+
+    auto zone_burns = [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k,
+                                                  Array4<Real const> const& U,
+                                                  Array4<Real const> const& mask,
+                                                  Array4<int const> const& retry_mask) -> bool
+    {
+        // Don't burn on zones inside shock regions, if the relevant option is set.
+
+#ifdef SHOCK_VAR
+        if (U(i,j,k,USHK) > 0.0_rt && disable_shock_burning == 1) {
+            return false;
+        }
 #endif
-        {
+        // Don't burn on zones that are masked out.
 
-            burn_t burn_state;
+        if (mask_covered_zones && mask.contains(i,j,k)) {
+            if (mask(i,j,k) == 0.0_rt) {
+                return false;
+            }
+        }
+
+        // Don't burn on zones that are not being advanced in this
+        // pass of a local retry.
+
+        if (pass > 0 && retry_mask.contains(i,j,k)) {
+            if (retry_local_skip(pass, retry_mask(i,j,k))) {
+                return false;
+            }
+        }
+
+        // Don't burn if we're outside of the relevant (rho, T) range.
+
+        if (U(i,j,k,UTEMP) < castro::react_T_min || U(i,j,k,UTEMP) > castro::react_T_max ||
+            U(i,j,k,URHO) < castro::react_rho_min || U(i,j,k,URHO) > castro::react_rho_max) {
+            return false;
+        }
+
+        return true;
+    };
+
+    // Burn a single zone (or, if do_burn is false, just zero out its
+    // reactions data). Returns 1 if the burn failed.
+
+    auto burn_zone = [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, bool do_burn,
+                                                 Array4<Real> const& U,
+                                                 Array4<Real> const& reactions,
+                                                 Array4<Real> const& weights) -> int
+    {
+        burn_t burn_state;
 #ifdef NSE_NET
-            burn_state.mu_p = U(i,j,k,UMUP);
-            burn_state.mu_n = U(i,j,k,UMUN);
+        burn_state.mu_p = U(i,j,k,UMUP);
+        burn_state.mu_n = U(i,j,k,UMUN);
 
-            burn_state.y_e = -1.0_rt;
+        burn_state.y_e = -1.0_rt;
 #endif
 
 #if AMREX_SPACEDIM == 1
-            burn_state.dx = dx[0];
+        burn_state.dx = dx[0];
 #else
-            burn_state.dx = amrex::min(AMREX_D_DECL(dx[0], dx[1], dx[2]));
+        burn_state.dx = amrex::min(AMREX_D_DECL(dx[0], dx[1], dx[2]));
 #endif
 
-            // Initialize some data for later.
-
-            bool do_burn = true;
-            burn_state.success = true;
-            int burn_failed = 0;
-
-            // Don't burn on zones inside shock regions, if the relevant option is set.
+        // Initialize some data for later.
 
-#ifdef SHOCK_VAR
-            if (U(i,j,k,USHK) > 0.0_rt && disable_shock_burning == 1) {
-                do_burn = false;
-            }
-#endif
-            // Don't burn on zones that are masked out.
-
-            if (mask_covered_zones && mask.contains(i,j,k)) {
-                if (mask(i,j,k) == 0.0_rt) {
-                    do_burn = false;
-                }
-            }
+        burn_state.success = true;
+        int burn_failed = 0;
 
-            Real rhoInv = 1.0_rt / U(i,j,k,URHO);
+        Real rhoInv = 1.0_rt / U(i,j,k,URHO);
 
-            burn_state.rho = U(i,j,k,URHO);
+        burn_state.rho = U(i,j,k,URHO);
 
-            // e is used as an input for some NSE solvers
+        // e is used as an input for some NSE solvers
 
-            burn_state.e = U(i,j,k,UEINT) * rhoInv;
+        burn_state.e = U(i,j,k,UEINT) * rhoInv;
 
-            // this T is consistent with UEINT because we did an EOS call before
-            // calling this function
+        // this T is consistent with UEINT because we did an EOS call before
+        // calling this function
 
-            burn_state.T = U(i,j,k,UTEMP);
+        burn_state.T = U(i,j,k,UTEMP);
 
-            burn_state.T_fixed = -1.e30_rt;
+        burn_state.T_fixed = -1.e30_rt;
 
 #ifdef MODEL_PARSER
-            if (drive_initial_convection) {
-                Real rr[3] = {0.0_rt};
+        if (drive_initial_convection) {
+            Real rr[3] = {0.0_rt};
 
-                rr[0] = problo[0] + dx[0] * (static_cast<Real>(i) + 0.5_rt) - problem::center[0];
+            rr[0] = problo[0] + dx[0] * (static_cast<Real>(i) + 0.5_rt) - problem::center[0];
 #if AMREX_SPACEDIM >= 2
-                rr[1] = problo[1] + dx[1] * (static_cast<Real>(j) + 0.5_rt) - problem::center[1];
+            rr[1] = problo[1] + dx[1] * (static_cast<Real>(j) + 0.5_rt) - problem::center[1];
 #endif
 #if AMREX_SPACEDIM == 3
-                rr[2] = problo[2] + dx[2] * (static_cast<Real>(k) + 0.5_rt) - problem::center[2];
+            rr[2] = problo[2] + dx[2] * (static_cast<Real>(k) + 0.5_rt) - problem::center[2];
 #endif
 
-                Real dist;
+            Real dist;
 
-                if (domain_is_plane_parallel) {
-                    dist = rr[AMREX_SPACEDIM-1];
-                } else {
-                    dist = std::sqrt(rr[0] * rr[0] + rr[1] * rr[1] + rr[2] * rr[2]);
-                }
+            if (domain_is_plane_parallel) {
+                dist = rr[AMREX_SPACEDIM-1];
+            } else {
+                dist = std::sqrt(rr[0] * rr[0] + rr[1] * rr[1] + rr[2] * rr[2]);
+            }
 
-                burn_state.T_fixed = interpolate(dist, model::itemp);
+            burn_state.T_fixed = interpolate(dist, model::itemp);
 
-            }
+        }
 #endif
 
-            for (int n = 0; n < NumSpec; ++n) {
-                burn_state.xn[n] = U(i,j,k,UFS+n) * rhoInv;
-            }
+        for (int n = 0; n < NumSpec; ++n) {
+            burn_state.xn[n] = U(i,j,k,UFS+n) * rhoInv;
+        }
 
 #if NAUX_NET > 0
-            for (int n = 0; n < NumAux; ++n) {
-                burn_state.aux[n] = U(i,j,k,UFX+n) * rhoInv;
-            }
+        for (int n = 0; n < NumAux; ++n) {
+            burn_state.aux[n] = U(i,j,k,UFX+n) * rhoInv;
+        }
 #endif
 
-            // Ensure we start with no RHS or Jacobian calls registered.
+        // Ensure we start with no RHS or Jacobian calls registered.
 
-            burn_state.n_rhs = 0;
-            burn_state.n_jac = 0;
+        burn_state.n_rhs = 0;
+        burn_state.n_jac = 0;
 
-            // for diagnostics
+        // for diagnostics
 
-            burn_state.i = i;
-            burn_state.j = j;
-            burn_state.k = k;
+        burn_state.i = i;
+        burn_state.j = j;
+        burn_state.k = k;
 
 #ifdef NONAKA_PLOT
-            burn_state.level = level;
-            burn_state.reference_time = time;
+        burn_state.level = level;
+        burn_state.reference_time = time;
 #ifdef STRANG
-            burn_state.strang_half = strang_half;
+        burn_state.strang_half = strang_half;
 #endif
 #endif
 
-            // Don't burn if we're outside of the relevant (rho, T) range.
-
-            if (burn_state.T < castro::react_T_min || burn_state.T > castro::react_T_max ||
-                burn_state.rho < castro::react_rho_min || burn_state.rho > castro::react_rho_max) {
-                do_burn = false;
-            }
+        if (do_burn) {
+            burner(burn_state, dt);
 
-            if (do_burn) {
-                burner(burn_state, dt);
-
-                // If we were unsuccessful, update the failure count.
+            // If we were unsuccessful, update the failure count.
 
-                if (!burn_state.success) {
-                    burn_failed = 1;
-                }
+            if (!burn_state.success) {
+                burn_failed = 1;
+            }
 
-                // Add burning rates to reactions MultiFab, but be
-                // careful because the reactions and state MFs may
-                // not have the same number of ghost cells.
+            // Add burning rates to reactions MultiFab, but be
+            // careful because the reactions and state MFs may
+            // not have the same number of ghost cells.
 
-                if (reactions.contains(i,j,k)) {
+            if (reactions.contains(i,j,k)) {
 
-                    reactions(i,j,k,0) = (U(i,j,k,URHO) * burn_state.e - U(i,j,k,UEINT)) / dt;
+                reactions(i,j,k,0) = (U(i,j,k,URHO) * burn_state.e - U(i,j,k,UEINT)) / dt;
 
-                    if (store_omegadot == 1) {
-                        if (reactions.contains(i,j,k)) {
-                            for (int n = 0; n < NumSpec; ++n) {
-                                reactions(i,j,k,1+n) = U(i,j,k,URHO) * (burn_state.xn[n] - U(i,j,k,UFS+n) * rhoInv) / dt;
-                            }
+                if (store_omegadot == 1) {
+                    if (reactions.contains(i,j,k)) {
+                        for (int n = 0; n < NumSpec; ++n) {
+                            reactions(i,j,k,1+n) = U(i,j,k,URHO) * (burn_state.xn[n] - U(i,j,k,UFS+n) * rhoInv) / dt;
+                        }
 #if NAUX_NET > 0
-                            for (int n = 0; n < NumAux; ++n) {
-                                reactions(i,j,k,1+n+NumSpec) = U(i,j,k,URHO) * (burn_state.aux[n] - U(i,j,k,UFX+n) * rhoInv) / dt;
-                            }
-#endif
+                        for (int n = 0; n < NumAux; ++n) {
+                            reactions(i,j,k,1+n+NumSpec) = U(i,j,k,URHO) * (burn_state.aux[n] - U(i,j,k,UFX+n) * rhoInv) / dt;
                         }
+#endif
                     }
+                }
 
-                    if (store_burn_weights) {
+                if (record_weights) {
 
-                        if (jacobian == 1) {
-                            weights(i,j,k,strang_half) = amrex::max(1.0_rt, static_cast<Real>(burn_state.n_rhs + 2 * burn_state.n_jac));
-                        } else {
-                            // the RHS evals for the numerical differencing in the Jacobian are already accounted for in n_rhs
-                            weights(i,j,k,strang_half) = amrex::max(1.0_rt, static_cast<Real>(burn_state.n_rhs));
-                        }
+                    if (jacobian == 1) {
+                        weights(i,j,k,strang_half) = amrex::max(1.0_rt, static_cast<Real>(burn_state.n_rhs + 2 * burn_state.n_jac));
+                    } else {
+                        // the RHS evals for the numerical differencing in the Jacobian are already accounted for in n_rhs
+                        weights(i,j,k,strang_half) = amrex::max(1.0_rt, static_cast<Real>(burn_state.n_rhs));
                     }
+                }
 #ifdef NSE
-                    if (store_omegadot == 1) {
-                        reactions(i,j,k,NumSpec+NumAux+1) = burn_state.nse;
-                    }
-                    else {
-                        reactions(i,j,k,1) = burn_state.nse;
-                    }
-#endif
+                if (store_omegadot == 1) {
+                    reactions(i,j,k,NumSpec+NumAux+1) = burn_state.nse;
+                }
+                else {
+                    reactions(i,j,k,1) = burn_state.nse;
                 }
+#endif
+            }
 
-                // update the state
+            // update the state
 #ifdef NSE_NET
-                U(i,j,k,UMUP) = burn_state.mu_p;
-                U(i,j,k,UMUN) = burn_state.mu_n;
+            U(i,j,k,UMUP) = burn_state.mu_p;
+            U(i,j,k,UMUN) = burn_state.mu_n;
 #endif
-                for (int n = 0; n < NumSpec; ++n) {
-                    U(i,j,k,UFS+n) = U(i,j,k,URHO) * burn_state.xn[n];
-                }
+            for (int n = 0; n < NumSpec; ++n) {
+                U(i,j,k,UFS+n) = U(i,j,k,URHO) * burn_state.xn[n];
+            }
 #if NAUX_NET > 0
-                for (int n = 0; n < NumAux; ++n) {
-                    U(i,j,k,UFX+n) = U(i,j,k,URHO) * burn_state.aux[n];
+            for (int n = 0; n < NumAux; ++n) {
+                U(i,j,k,UFX+n) = U(i,j,k,URHO) * burn_state.aux[n];
+            }
+#endif
+            Real reint_old = U(i,j,k,UEINT);
+            U(i,j,k,UEINT) = U(i,j,k,URHO) * burn_state.e;
+            U(i,j,k,UEDEN) += U(i,j,k,UEINT) - reint_old;
+
+        } else {  // do_burn = false
+
+            if (reactions.contains(i,j,k)) {
+                for (int n = 0; n < reactions.nComp(); n++) {
+                    reactions(i,j,k,n) = 0.0_rt;
                 }
+            }
+
+            if (record_weights && weights.contains(i,j,k)) {
+                weights(i,j,k,strang_half) = 0.0_rt;
+            }
+
+        }
+
+
+        return burn_failed;
+    };
+
+#if defined(AMREX_USE_GPU)
+    Gpu::Buffer<int> d_num_failed({0});
+    auto* p_num_failed = d_num_failed.data();
 #endif
-                Real reint_old = U(i,j,k,UEINT);
-                U(i,j,k,UEINT) = U(i,j,k,URHO) * burn_state.e;
-                U(i,j,k,UEDEN) += U(i,j,k,UEINT) - reint_old;
+    int num_failed = 0;
 
-            } else {  // do_burn = false
+    if (react_batched == 0 || !record_weights) {
 
-                if (reactions.contains(i,j,k)) {
-                    for (int n = 0; n < reactions.nComp(); n++) {
-                        reactions(i,j,k,n) = 0.0_rt;
-                    }
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:num_failed)
+#endif
+        for (MFIter mfi(s, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+
+            const Box& bx = mfi.growntilebox(ng);
+
+            auto U = s.array(mfi);
+            auto reactions = r.array(mfi);
+            auto weights = record_weights ? burn_weights.array(mfi) : Array4<Real>{};
+            const auto mask = mask_covered_zones ? mask_mf.const_array(mfi) : Array4<Real const>{};
+            const auto retry_mask = pass > 0 ? retry_local_mask.const_array(mfi) : Array4<int const>{};
+            const int box_index = mfi.index();
+
+#if defined(AMREX_USE_GPU)
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+#else
+            LoopOnCpu(bx, [&] (int i, int j, int k) mutable
+#endif
+            {
+                const bool do_burn = zone_burns(i, j, k, U, mask, retry_mask);
+
+                int burn_failed = burn_zone(i, j, k, do_burn, U, reactions, weights);
+
+#if defined(AMREX_USE_GPU)
+                if (burn_failed) {
+                    Gpu::Atomic::Add(p_num_failed, burn_failed);
+                }
+#else
+                num_failed += burn_failed;
+#endif
+
+                if (p_box_failed && burn_failed) {
+                    // tiles of the same box may be burned by different threads
+                    HostDevice::Atomic::Add(p_box_failed + box_index, burn_failed);
                 }
+            });
+
+#if defined(AMREX_USE_HIP)
+            Gpu::streamSynchronize(); // otherwise HIP may fail to allocate the necessary resources.
+#endif
+        }
+
+#if defined(AMREX_USE_GPU)
+        num_failed = *(d_num_failed.copyToHost());
+#endif
+
+    }
+    else {
 
+        // Batched mode: rather than burning the zones in grid order, which
+        // mixes zones that don't burn with stiff zones in the same warp (or
+        // vector lane group), we first compact all of the zones on this rank
+        // that will burn into a packed list, then order them from most to
+        // least expensive using the number of RHS evaluations they needed
+        // the last time (binned in powers of 2), and finally burn them in
+        // that order, so that the zones burned together have a similar cost.
+
+        constexpr int nbins = 32;
+
+        auto cost_bin = [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k, Array4<Real const> const& weights) -> int
+        {
+            // Ghost zones get the cost of the nearest valid zone.
+
+            const auto lo = amrex::lbound(weights);
+            const auto hi = amrex::ubound(weights);
+
+            Real cost = weights(amrex::Clamp(i, lo.x, hi.x),
+                                amrex::Clamp(j, lo.y, hi.y),
+                                amrex::Clamp(k, lo.z, hi.z), strang_half);
+
+            int bin = 0;
+            while (cost >= 2.0_rt && bin < nbins - 1) {
+                cost *= 0.5_rt;
+                ++bin;
             }
 
+            return bin;
+        };
+
+        const auto U_ma = s.arrays();
+        const auto reactions_ma = r.arrays();
+        const auto weights_ma = burn_weights.arrays();
+
+        // Each box gets its own range of slots in the compacted list, so
+        // that the boxes can be compacted independently (on the CPU, by
+        // different OpenMP threads).  Unused slots keep a bin of -1.
+
+        Long max_zones = 0;
+        Vector<Long> h_box_start(s.local_size());
+        for (MFIter mfi(s); mfi.isValid(); ++mfi) {
+            h_box_start[mfi.LocalIndex()] = max_zones;
+            max_zones += mfi.growntilebox(ng).numPts();
+        }
+
+        Gpu::DeviceVector<int> box_index(s.local_size());
+        Gpu::copyAsync(Gpu::hostToDevice, s.IndexArray().begin(), s.IndexArray().end(), box_index.begin());
+        const int* p_box_index = box_index.data();
+
+        // Compact the zones that burn, recording the cost bin of each one.
+
+        Gpu::DeviceVector<burn_zone_index> unsorted_zones(max_zones);
+        Gpu::DeviceVector<int> zone_bin(max_zones, -1);
+        Gpu::DeviceVector<int> box_count(s.local_size(), 0);
+
+        auto* p_unsorted_zones = unsorted_zones.data();
+        auto* p_zone_bin = zone_bin.data();
+        auto* p_box_count = box_count.data();
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(s); mfi.isValid(); ++mfi) {
+
+            const Box& bx = mfi.growntilebox(ng);
+            const int li = mfi.LocalIndex();
+            const Long start = h_box_start[li];
+
+            auto U = s.const_array(mfi);
+            auto weights = burn_weights.const_array(mfi);
+            const auto mask = mask_covered_zones ? mask_mf.const_array(mfi) : Array4<Real const>{};
+            const auto retry_mask = pass > 0 ? retry_local_mask.const_array(mfi) : Array4<int const>{};
+
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                if (zone_burns(i, j, k, U, mask, retry_mask)) {
+                    // Only this box (and so, on the CPU, only this
+                    // thread) updates its count.
+                    const Long n = start + Gpu::Atomic::Add(p_box_count + li, 1);
+
+                    p_unsorted_zones[n] = burn_zone_index{li, i, j, k};
+                    p_zone_bin[n] = cost_bin(i, j, k, weights);
+                }
+            });
+
+        }
+
+        // Count the zones in each bin.  The last entry of bin_count is the
+        // total number of burning zones.  Outside of the MFIter loop, the
+        // host ParallelFor is serial, so these atomics are safe on the CPU.
+
+        Gpu::DeviceVector<int> bin_count(nbins + 1, 0);
+        auto* p_bin_count = bin_count.data();
+
+        amrex::ParallelFor(max_zones,
+        [=] AMREX_GPU_DEVICE (Long n) noexcept
+        {
+            const int bin = p_zone_bin[n];
+            if (bin >= 0) {
+                Gpu::Atomic::Add(p_bin_count + bin, 1);
+                Gpu::Atomic::Add(p_bin_count + nbins, 1);
+            }
+        });
+
+        // Sort the zones by bin, most expensive first (a counting sort).
+
+        Vector<int> h_bin_count(nbins + 1);
+        Gpu::copy(Gpu::deviceToHost, bin_count.begin(), bin_count.end(), h_bin_count.begin());
+
+        const int num_zones = h_bin_count[nbins];
+
+        Vector<int> h_bin_offset(nbins, 0);
+        int offset = 0;
+        for (int bin = nbins - 1; bin >= 0; --bin) {
+            h_bin_offset[bin] = offset;
+            offset += h_bin_count[bin];
+        }
+
+        Gpu::DeviceVector<int> bin_offset(nbins);
+        Gpu::copyAsync(Gpu::hostToDevice, h_bin_offset.begin(), h_bin_offset.end(), bin_offset.begin());
+        auto* p_bin_offset = bin_offset.data();
+
+        // Reuse the counts to fill the bins.
+
+        bin_count.assign(nbins + 1, 0);
+
+        Gpu::DeviceVector<burn_zone_index> sorted_zones(num_zones);
+        auto* p_sorted_zones = sorted_zones.data();
+
+        amrex::ParallelFor(max_zones,
+        [=] AMREX_GPU_DEVICE (Long n) noexcept
+        {
+            const int bin = p_zone_bin[n];
+            if (bin >= 0) {
+                const int m = p_bin_offset[bin] + Gpu::Atomic::Add(p_bin_count + bin, 1);
+                p_sorted_zones[m] = p_unsorted_zones[n];
+            }
+        });
+
+        // Now do the burn. On the CPU each thread takes a contiguous batch of
+        // react_batch_size zones at a time, so that the expensive zones at the
+        // start of the list are spread over all of the threads.
+
 #if defined(AMREX_USE_GPU)
+        amrex::ParallelFor(num_zones,
+        [=] AMREX_GPU_DEVICE (int n) noexcept
+        {
+            const auto z = p_sorted_zones[n];
+
+            int burn_failed = burn_zone(z.i, z.j, z.k, true, U_ma[z.box], reactions_ma[z.box], weights_ma[z.box]);
+
             if (burn_failed) {
                 Gpu::Atomic::Add(p_num_failed, burn_failed);
+
+                if (p_box_failed) {
+                    Gpu::Atomic::Add(p_box_failed + p_box_index[z.box], burn_failed);
+                }
             }
+        });
+
+        num_failed = *(d_num_failed.copyToHost());
 #else
-            num_failed += burn_failed;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, react_batch_size) reduction(+:num_failed)
 #endif
-        });
+        for (int n = 0; n < num_zones; ++n) {
+            const auto z = p_sorted_zones[n];
 
-#if defined(AMREX_USE_HIP)
-        Gpu::streamSynchronize(); // otherwise HIP may fail to allocate the necessary resources.
+            int burn_failed = burn_zone(z.i, z.j, z.k, true, U_ma[z.box], reactions_ma[z.box], weights_ma[z.box]);
+
+            num_failed += burn_failed;
+
+            if (p_box_failed && burn_failed) {
+                // Zones of the same box may be burned by different threads.
+                HostDevice::Atomic::Add(p_box_failed + p_box_index[z.box], burn_failed);
+            }
+        }
 #endif
-    }
 
-#if defined(AMREX_USE_GPU)
-    num_failed = *(d_num_failed.copyToHost());
+        // Finally, zero out the reactions data (and weights) for the zones
+        // that did not burn.
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
+        for (MFIter mfi(s, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+
+            const Box& bx = mfi.growntilebox(ng);
+
+            auto U = s.array(mfi);
+            auto reactions = r.array(mfi);
+            auto weights = burn_weights.array(mfi);
+            const auto mask = mask_covered_zones ? mask_mf.const_array(mfi) : Array4<Real const>{};
+            const auto retry_mask = pass > 0 ? retry_local_mask.const_array(mfi) : Array4<int const>{};
+
+            amrex::ParallelFor(bx,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                if (!zone_burns(i, j, k, U, mask, retry_mask)) {
+                    burn_zone(i, j, k, false, U, reactions, weights);
+                }
+            });
+
+        }
+
+    }
 
     burn_success = !num_failed;
 
+    if (record_failed_boxes && num_failed > 0) {
+        record_retry_failed_boxes(box_failed);
+    }
+
     ParallelDescriptor::ReduceIntMin(burn_success);
 
     if (print_update_diagnostics) {
@@ -523,6 +817,11 @@ Castro::react_state(Real time, Real dt)
     MultiFab tmp_mask_mf;
     const MultiFab& mask_mf = mask_covered_zones ? getLevel(level+1).build_fine_mask() : tmp_mask_mf;
 
+    // burn_weights is allocated if we are storing it in the plotfile
+    // or using it for load balancing
+
+    const bool record_weights = burn_weights.isDefined();
+
     // Start off assuming a successful burn.
 
     int burn_success = 1;
@@ -547,7 +846,7 @@ Castro::react_state(Real time, Real dt)
 #endif
         auto I     = SDC_react.array(mfi);
         auto react_src = reactions.array(mfi);
-        auto weights = store_burn_weights ? burn_weights.array(mfi) : Array4<Real>{};
+        auto weights = record_weights ? burn_weights.array(mfi) : Array4<Real>{};
         const auto mask = mask_covered_zones ? mask_mf.array(mfi) : Array4<Real>{};
 
         int lsdc_iteration = sdc_iteration;
@@ -746,7 +1045,7 @@ Castro::react_state(Real time, Real dt)
 
                     // burn weights
 
-                    if (store_burn_weights) {
+                    if (record_weights) {
 
                          if (jacobian == 1) {
                              weights(i,j,k,lsdc_iteration) = amrex::max(1.0_rt, static_cast<Real>(burn_state.n_rhs + 2 * burn_state.n_jac));
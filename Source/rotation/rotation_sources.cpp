@@ -1,6 +1,7 @@
 #include <Castro.H>
 #include <Castro_util.H>
 #include <Rotation.H>
+#include <rotation_sources.H>
 #ifdef HYBRID_MOMENTUM
 #include <hybrid.H>
 #endif
@@ -17,109 +18,9 @@ Castro::rsrc(const Box& bx,
   [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
   {
 
-    Real Sr[3] = {};
-    Real src[NSRC] = {};
-
-    // Temporary array for seeing what the new state would be if the update were applied here.
-
-    Real snew[NUM_STATE] = {};
-
-    GpuArray<Real, 3> loc;
-    position(i, j, k, geomdata, loc);
-
-    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
-      loc[dir] -= problem::center[dir];
-    }
-
-    Real rho = uold(i,j,k,URHO);
-    Real rhoInv = 1.0_rt / rho;
-
-    for (int n = 0; n < NUM_STATE; n++) {
-      snew[n] = uold(i,j,k,n);
-    }
-
-    Real old_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoInv;
-
-    GpuArray<Real, 3> v;
-
-    v[0] = uold(i,j,k,UMX) * rhoInv;
-    v[1] = uold(i,j,k,UMY) * rhoInv;
-    v[2] = uold(i,j,k,UMZ) * rhoInv;
-
-    bool coriolis = true;
-    rotational_acceleration(loc, v, coriolis, Sr);
-
-    for (int n = 0; n < 3; n++) {
-        Sr[n] = rho * Sr[n];
-    }
-
-    src[UMX] = Sr[0];
-    src[UMY] = Sr[1];
-    src[UMZ] = Sr[2];
-
-    snew[UMX] += dt * src[UMX];
-    snew[UMY] += dt * src[UMY];
-    snew[UMZ] += dt * src[UMZ];
-
-#ifdef HYBRID_MOMENTUM
-    GpuArray<Real, 3> linear_momentum;
-    linear_momentum[0] = src[UMX];
-    linear_momentum[1] = src[UMY];
-    linear_momentum[2] = src[UMZ];
-
-    GpuArray<Real, 3> hybrid_source;
-    set_hybrid_momentum_source(loc, linear_momentum, hybrid_source);
-
-    snew[UMR] += dt * hybrid_source[0];
-    snew[UML] += dt * hybrid_source[1];
-    snew[UMP] += dt * hybrid_source[2];
-
-    src[UMR] = hybrid_source[0];
-    src[UML] = hybrid_source[1];
-    src[UMP] = hybrid_source[2];
-#endif
-
-    // Kinetic energy source: this is v . the momentum source.
-    // We don't apply in the case of the conservative energy
-    // formulation.
-
-    Real SrE;
-
-    if (rot_source_type == 1 || rot_source_type == 2) {
-
-      SrE = uold(i,j,k,UMX) * rhoInv * Sr[0] +
-            uold(i,j,k,UMY) * rhoInv * Sr[1] +
-            uold(i,j,k,UMZ) * rhoInv * Sr[2];
-
-    } else if (rot_source_type == 3) {
-
-      Real new_ke = 0.5_rt * (snew[UMX] * snew[UMX] + snew[UMY] * snew[UMY] + snew[UMZ] * snew[UMZ]) * rhoInv;
-      SrE = new_ke - old_ke;
-
-    } else if (rot_source_type == 4) {
-
-      // The conservative energy formulation does not strictly require
-      // any energy source-term here, because it depends only on the
-      // fluid motions from the hydrodynamical fluxes which we will only
-      // have when we get to the 'corrector' step. Nevertheless we add a
-      // predictor energy source term in the way that the other methods
-      // do, for consistency. We will fully subtract this predictor value
-      // during the corrector step, so that the final result is correct.
-      // Here we use the same approach as rot_source_type == 2.
-
-      SrE = uold(i,j,k,UMX) * rhoInv * Sr[0] +
-            uold(i,j,k,UMY) * rhoInv * Sr[1] +
-            uold(i,j,k,UMZ) * rhoInv * Sr[2];
-
-    } else {
-#ifndef AMREX_USE_GPU
-      amrex::Error("Error:: rotation_sources_nd.F90 :: invalid rot_source_type");
-#endif
-    }
-
-    src[UEDEN] += SrE;
+    Real src[NSRC];
 
-    snew[UEDEN] += dt * src[UEDEN];
+    old_rotation_source_zone(i, j, k, uold, dt, geomdata, src);
 
     // Add to the outgoing source array.
 
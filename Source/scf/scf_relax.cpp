@@ -60,8 +60,8 @@ void
 Castro::do_hscf_solve()
 {
 
-    const int finest_level = parent->finestLevel();
-    const int n_levs = finest_level + 1;
+    const int amr_finest_level = parent->finestLevel();
+    const int n_levs = amr_finest_level + 1;
 
     // Do the initial relaxation setup. We need to fix two points
     // to uniquely determine an equilibrium configuration for a
@@ -96,7 +96,7 @@ Castro::do_hscf_solve()
 
     Real target_h_max = 0.0;
 
-    for (int lev = 0; lev <= finest_level; ++lev) {
+    for (int lev = 0; lev <= amr_finest_level; ++lev) {
 
         MultiFab& state_new = getLevel(lev).get_new_data(State_Type);
 
@@ -153,10 +153,20 @@ Castro::do_hscf_solve()
 
     int ctr = 1;
 
+    const bool accelerate = castro::scf_accelerate == 1;
+
+    // In the accelerated mode, the first iterations of a multilevel
+    // run can be done on the coarse level alone.
+
+    bool coarse_phase = accelerate && castro::scf_coarse_iterations > 0 && amr_finest_level > 0;
+    int coarse_ctr = 0;
+
     while (ctr <= scf_max_iterations) {
 
         Real time = getLevel(0).state[State_Type].curTime();
 
+        const int finest_level = coarse_phase ? 0 : amr_finest_level;
+
         // Construct a local MultiFab for the rotational psi.
         // This does not change over the loop iterations, but
         // this (and the data to follow) must be constructed
@@ -314,10 +324,14 @@ Castro::do_hscf_solve()
 
         }
 
-        ParallelDescriptor::ReduceRealSum(phi_A);
-        ParallelDescriptor::ReduceRealSum(psi_A);
-        ParallelDescriptor::ReduceRealSum(phi_B);
-        ParallelDescriptor::ReduceRealSum(psi_B);
+        {
+            Real point_sums[4] = {phi_A, psi_A, phi_B, psi_B};
+            ParallelDescriptor::ReduceRealSum(point_sums, 4);
+            phi_A = point_sums[0];
+            psi_A = point_sums[1];
+            phi_B = point_sums[2];
+            psi_B = point_sums[3];
+        }
 
         // Now update the square of the rotation frequency, following Hachisu (Equation 16).
         // Deal carefully with the special case where phi_A and phi_B are equal -- we assume
@@ -355,88 +369,110 @@ Castro::do_hscf_solve()
 
         Real bernoulli = 0.0;
 
-        for (int lev = 0; lev <= finest_level; ++lev) {
+        if (accelerate) {
 
-            auto geomdata = parent->Geom(lev).data();
+            // psi is the rotational potential divided by omega**2, so
+            // the sums at point A from the first step already give us
+            // the Bernoulli constant for the updated rotation rate.
 
-            ReduceOps<ReduceOpSum> reduce_op;
-            ReduceData<Real> reduce_data(reduce_op);
-            using ReduceTuple = typename decltype(reduce_data)::Type;
+            auto omega = get_omega();
+            Real omegasq = omega[0] * omega[0] + omega[1] * omega[1] + omega[2] * omega[2];
+
+            bernoulli = phi_A + omegasq * psi_A;
+
+        }
+        else {
+
+            for (int lev = 0; lev <= finest_level; ++lev) {
+
+                auto geomdata = parent->Geom(lev).data();
+
+                ReduceOps<ReduceOpSum> reduce_op;
+                ReduceData<Real> reduce_data(reduce_op);
+                using ReduceTuple = typename decltype(reduce_data)::Type;
 
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
-            for (MFIter mfi((*phi[lev]), TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+                for (MFIter mfi((*phi[lev]), TilingIfNotGPU()); mfi.isValid(); ++mfi) {
 
-                const Box& bx = mfi.tilebox();
+                    const Box& bx = mfi.tilebox();
 
-                auto phi_arr = (*phi[lev])[mfi].array();
+                    auto phi_arr = (*phi[lev])[mfi].array();
 
-                reduce_op.eval(bx, reduce_data,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
-                {
-                    const auto *dx = geomdata.CellSize();
-                    const auto *problo = geomdata.ProbLo();
+                    reduce_op.eval(bx, reduce_data,
+                    [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                    {
+                        const auto *dx = geomdata.CellSize();
+                        const auto *problo = geomdata.ProbLo();
 
-                    // The below assumes we are rotating on the z-axis.
+                        // The below assumes we are rotating on the z-axis.
 
-                    GpuArray<Real, 3> r = {0.0};
+                        GpuArray<Real, 3> r = {0.0};
 
-                    r[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0];
+                        r[0] = problo[0] + (static_cast<Real>(i) + 0.5_rt) * dx[0] - problem::center[0];
 #if AMREX_SPACEDIM >= 2
-                    r[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1];
+                        r[1] = problo[1] + (static_cast<Real>(j) + 0.5_rt) * dx[1] - problem::center[1];
 #endif
 #if AMREX_SPACEDIM == 3
-                    r[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2];
+                        r[2] = problo[2] + (static_cast<Real>(k) + 0.5_rt) * dx[2] - problem::center[2];
 #endif
 
-                    // Do a trilinear interpolation to find the contribution from
-                    // this grid point. Limit so that only the nearest zone centers
-                    // can participate. This implies that the maximum allowable
-                    // distance from the target location is 0.5 * dx.
+                        // Do a trilinear interpolation to find the contribution from
+                        // this grid point. Limit so that only the nearest zone centers
+                        // can participate. This implies that the maximum allowable
+                        // distance from the target location is 0.5 * dx.
 
-                    Real rr[3] = {0.0};
+                        Real rr[3] = {0.0};
 
-                    rr[0] = std::abs(r[0] - scf_r_A[0]) / dx[0];
+                        rr[0] = std::abs(r[0] - scf_r_A[0]) / dx[0];
 #if AMREX_SPACEDIM >= 2
-                    rr[1] = std::abs(r[1] - scf_r_A[1]) / dx[1];
+                        rr[1] = std::abs(r[1] - scf_r_A[1]) / dx[1];
 #endif
 #if AMREX_SPACEDIM == 3
-                    rr[2] = std::abs(r[2] - scf_r_A[2]) / dx[2];
+                        rr[2] = std::abs(r[2] - scf_r_A[2]) / dx[2];
 #endif
-                    Real scale;
+                        Real scale;
 
-                    if (rr[0] > 1.0_rt || rr[1] > 1.0_rt || rr[2] > 1.0_rt) {
-                        scale = 0.0;
-                    }
-                    else {
-                        scale = (1.0_rt - rr[0]) * (1.0_rt - rr[1]) * (1.0_rt - rr[2]);
-                    }
+                        if (rr[0] > 1.0_rt || rr[1] > 1.0_rt || rr[2] > 1.0_rt) {
+                            scale = 0.0;
+                        }
+                        else {
+                            scale = (1.0_rt - rr[0]) * (1.0_rt - rr[1]) * (1.0_rt - rr[2]);
+                        }
 
-                    Real bernoulli_zone = scale * (phi_arr(i,j,k) + rotational_potential(r));
+                        Real bernoulli_zone = scale * (phi_arr(i,j,k) + rotational_potential(r));
 
-                    return {bernoulli_zone};
-                });
+                        return {bernoulli_zone};
+                    });
+
+                }
+
+                ReduceTuple hv = reduce_data.value();
+                bernoulli += amrex::get<0>(hv);
 
             }
 
-            ReduceTuple hv = reduce_data.value();
-            bernoulli += amrex::get<0>(hv);
+            ParallelDescriptor::ReduceRealSum(bernoulli);
 
         }
 
-        ParallelDescriptor::ReduceRealSum(bernoulli);
-
 
 
         // Third step is to construct the enthalpy field and
-        // find the maximum enthalpy for the star.
+        // find the maximum enthalpy for the star. We find the
+        // maximum density at the same time.
+
+        Real actual_h_max = 0.0;
+        Real actual_rho_max = 0.0;
 
         for (int lev = 0; lev <= finest_level; ++lev) {
 
             auto geomdata = parent->Geom(lev).data();
 
-            enthalpy[lev]->setVal(0.0);
+            ReduceOps<ReduceOpMax, ReduceOpMax> reduce_op;
+            ReduceData<Real, Real> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -447,9 +483,10 @@ Castro::do_hscf_solve()
 
                 auto enthalpy_arr = (*enthalpy[lev])[mfi].array();
                 auto phi_arr = (*phi[lev])[mfi].array();
+                auto state_arr = (*state_vec[lev])[mfi].array();
 
-                amrex::ParallelFor(bx,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                reduce_op.eval(bx, reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
                 {
                     // The Bernoulli equation says that energy is conserved:
                     // enthalpy + gravitational potential + rotational potential = const
@@ -469,20 +506,23 @@ Castro::do_hscf_solve()
 #endif
 
                     enthalpy_arr(i,j,k) = bernoulli - phi_arr(i,j,k) - rotational_potential(r);
+
+                    return {enthalpy_arr(i,j,k), state_arr(i,j,k,URHO)};
                 });
 
             }
 
-        }
-
-        Real actual_h_max = 0.0;
-        Real actual_rho_max = 0.0;
-
-        for (int lev = 0; lev <= finest_level; ++lev) {
+            ReduceTuple hv = reduce_data.value();
+            actual_h_max = amrex::max(actual_h_max, amrex::get<0>(hv));
+            actual_rho_max = amrex::max(actual_rho_max, amrex::get<1>(hv));
 
-            actual_h_max = std::max(actual_h_max, enthalpy[lev]->max(0));
-            actual_rho_max = std::max(actual_rho_max, state_vec[lev]->max(URHO));
+        }
 
+        {
+            Real maxima[2] = {actual_h_max, actual_rho_max};
+            ParallelDescriptor::ReduceRealMax(maxima, 2);
+            actual_h_max = maxima[0];
+            actual_rho_max = maxima[1];
         }
 
         Real Linf_norm = 0.0;
@@ -597,6 +637,12 @@ Castro::do_hscf_solve()
         }
 
         // Update the gravitational field -- only after we've completed cleaning up the state above.
+        // In the accelerated mode, the potential only needs to be accurate compared to how much the
+        // density is still changing.
+
+        if (accelerate) {
+            gravity->set_loose_rel_tol(castro::scf_poisson_tol_factor * Linf_norm);
+        }
 
         gravity->multilevel_solve_for_new_phi(0, finest_level);
 
@@ -690,10 +736,14 @@ Castro::do_hscf_solve()
 
         }
 
-        ParallelDescriptor::ReduceRealSum(kin_eng);
-        ParallelDescriptor::ReduceRealSum(pot_eng);
-        ParallelDescriptor::ReduceRealSum(int_eng);
-        ParallelDescriptor::ReduceRealSum(mass);
+        {
+            Real energy_sums[4] = {kin_eng, pot_eng, int_eng, mass};
+            ParallelDescriptor::ReduceRealSum(energy_sums, 4);
+            kin_eng = energy_sums[0];
+            pot_eng = energy_sums[1];
+            int_eng = energy_sums[2];
+            mass = energy_sums[3];
+        }
 
         Real virial_error = std::abs(2.0 * kin_eng + pot_eng + 3.0 * int_eng) / std::abs(pot_eng);
 
@@ -705,6 +755,36 @@ Castro::do_hscf_solve()
             is_relaxed = 1;
         }
 
+        // At the end of the coarse iterations, interpolate the coarse
+        // level to the fine levels and carry on with all of the levels.
+        // We always finish on the full hierarchy, so this is also done
+        // if we run out of iterations (scf_max_iterations) while still
+        // in the coarse phase.
+
+        if (coarse_phase) {
+
+            ++coarse_ctr;
+
+            if (is_relaxed == 1 || coarse_ctr == castro::scf_coarse_iterations ||
+                ctr == scf_max_iterations) {
+
+                for (int lev = 1; lev <= amr_finest_level; ++lev) {
+                    getLevel(lev).FillCoarsePatch(getLevel(lev).get_new_data(State_Type), 0, time, State_Type, 0, NUM_STATE);
+                    getLevel(lev).FillCoarsePatch(getLevel(lev).get_new_data(PhiGrav_Type), 0, time, PhiGrav_Type, 0, 1);
+                }
+
+                coarse_phase = false;
+
+                if (ParallelDescriptor::IOProcessor()) {
+                    std::cout << "   Finished the coarse level relaxation iterations" << std::endl;
+                }
+
+            }
+
+            is_relaxed = 0;
+
+        }
+
         if (ParallelDescriptor::IOProcessor()) {
 
             // Grab the value for the solar mass.
@@ -735,6 +815,13 @@ Castro::do_hscf_solve()
 
     }
 
+    // The last Poisson solve may have been done with a loose tolerance.
+
+    if (accelerate) {
+        gravity->set_loose_rel_tol(0.0);
+        gravity->multilevel_solve_for_new_phi(0, parent->finestLevel());
+    }
+
 }
 #endif
 #endif
@@ -1,6 +1,9 @@
 #include <Castro.H>
 // #include <Castro_hydro_F.H>
 #include <Castro_sdc_util.H>
+#ifdef REACTIONS
+#include <sdc_newton_batch.H>
+#endif
 
 using namespace amrex;
 
@@ -32,6 +35,12 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
     // the timestep from m to m+1
     Real dt_m = (dt_sdc[m_end] - dt_sdc[m_start]) * dt;
 
+#ifdef REACTIONS
+    // should we do the Newton solves for batches of zones at once?
+    const bool newton_batch = sdc_newton_batch == 1 &&
+        (sdc_solver == NEWTON_SOLVE || sdc_solver == HYBRID_SOLVE);
+#endif
+
 #ifdef REACTIONS
     // SDC_Source_Type is only defined for 4th order
     MultiFab tmp;
@@ -110,8 +119,8 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
 
         }
 
-        const Real cur_time = state[State_Type].curTime();
-        expand_state(Sburn, cur_time, 2);
+        const Real node_time = state[State_Type].prevTime() + dt_sdc[m_end] * dt;
+        expand_sdc_node_state(Sburn, node_time, 2);
 
     }
 #endif
@@ -177,11 +186,15 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
             auto A_n = (*A_new[m_end]).array(mfi);
             auto C_arr = C2.array();
 
-            amrex::ParallelFor(bx,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                sdc_update_o2(i, j, k, k_m, k_n, A_m, A_n, C_arr, dt_m, sdc_iteration, m_start);
-            });
+            if (newton_batch) {
+                sdc_update_o2_batch(bx, k_m, k_n, A_m, A_n, C_arr, dt_m, sdc_iteration);
+            } else {
+                amrex::ParallelFor(bx,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    sdc_update_o2(i, j, k, k_m, k_n, A_m, A_n, C_arr, dt_m, sdc_iteration, m_start);
+                });
+            }
         }
         else
         {
@@ -226,11 +239,15 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
             // an average in Sburn
             make_cell_center(bx1, Sburn.array(mfi), U_new_center_arr, domain_lo, domain_hi);
 
-            amrex::ParallelFor(bx1,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
-            {
-                sdc_update_centers_o4(i, j, k, U_center_arr, U_new_center_arr, C_center_arr, dt_m, sdc_iteration);
-            });
+            if (newton_batch) {
+                sdc_update_centers_o4_batch(bx1, U_center_arr, U_new_center_arr, C_center_arr, dt_m, sdc_iteration);
+            } else {
+                amrex::ParallelFor(bx1,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+                {
+                    sdc_update_centers_o4(i, j, k, U_center_arr, U_new_center_arr, C_center_arr, dt_m, sdc_iteration);
+                });
+            }
 
             // enforce that the species sum to one after the reaction solve
             amrex::ParallelFor(bx1,
@@ -321,6 +338,96 @@ Castro::do_sdc_update(int m_start, int m_end, Real dt)
 }
 
 
+void
+Castro::expand_sdc_node_state(MultiFab& S, Real node_time, int ng)
+{
+
+    BL_PROFILE("Castro::expand_sdc_node_state()");
+
+    // The node state has been copied into S_new.  On the coarsest level
+    // all of the ghost cells come from physical or periodic boundaries,
+    // so we can just fill from the new time.
+
+    const Real prev_time = state[State_Type].prevTime();
+    const Real cur_time = state[State_Type].curTime();
+
+    if (level == 0) {
+        expand_state(S, cur_time, ng);
+        return;
+    }
+
+    // On a fine level, the coarse-fine ghost cells need the coarse
+    // solution at node_time, which in general is not one of the coarse
+    // time levels, and linear interpolation between the coarse old and
+    // new states is only second-order in time.  The coarse level keeps
+    // its SDC node states until we have caught up to it, so instead we
+    // interpolate in time over those with the Lagrange polynomial
+    // through the coarse nodes, temporarily install the result as the
+    // coarse new data, and then do an ordinary FillPatch at node_time.
+
+    Castro& crse_lev = getLevel(level-1);
+    StateData& crse_state = crse_lev.state[State_Type];
+
+    AMREX_ALWAYS_ASSERT(static_cast<int>(crse_lev.k_new.size()) == SDC_NODES);
+
+    const Real crse_prev_time = crse_state.prevTime();
+    const Real crse_cur_time = crse_state.curTime();
+    const Real crse_dt = crse_cur_time - crse_prev_time;
+
+    // a time that coincides with one of the existing time levels is
+    // filled from that data directly (the StateData cannot have
+    // coincident old and new times)
+
+    const Real teps = 1.e-3_rt * crse_dt;
+
+    const bool interp_crse = node_time > crse_prev_time + teps &&
+                             node_time < crse_cur_time - teps;
+
+    const bool fine_at_new_time = node_time > prev_time + 1.e-3_rt * (cur_time - prev_time);
+
+    MultiFab& S_crse_new = crse_lev.get_new_data(State_Type);
+    MultiFab S_crse_node;
+
+    if (interp_crse) {
+
+        S_crse_node.define(S_crse_new.boxArray(), S_crse_new.DistributionMap(),
+                           S_crse_new.nComp(), S_crse_new.nGrow());
+        S_crse_node.setVal(0.0);
+
+        for (int n = 0; n < SDC_NODES; ++n) {
+            const Real t_n = crse_prev_time + dt_sdc[n] * crse_dt;
+
+            Real lagrange_weight = 1.0_rt;
+            for (int j = 0; j < SDC_NODES; ++j) {
+                if (j != n) {
+                    const Real t_j = crse_prev_time + dt_sdc[j] * crse_dt;
+                    lagrange_weight *= (node_time - t_j) / (t_n - t_j);
+                }
+            }
+
+            MultiFab::Saxpy(S_crse_node, lagrange_weight, *crse_lev.k_new[n], 0, 0, NUM_STATE, 0);
+        }
+
+        std::swap(S_crse_new, S_crse_node);
+        crse_state.setNewTimeLevel(node_time);
+    }
+
+    if (fine_at_new_time) {
+        state[State_Type].setNewTimeLevel(node_time);
+        AmrLevel::FillPatch(*this, S, ng, node_time, State_Type, 0, NUM_STATE);
+        state[State_Type].setNewTimeLevel(cur_time);
+    } else {
+        // we are at the first node, which is aliased to the old data
+        AmrLevel::FillPatch(*this, S, ng, prev_time, State_Type, 0, NUM_STATE);
+    }
+
+    if (interp_crse) {
+        crse_state.setNewTimeLevel(crse_cur_time);
+        std::swap(S_crse_new, S_crse_node);
+    }
+}
+
+
 #ifdef REACTIONS
 void
 Castro::construct_old_react_source(MultiFab& U_state,
@@ -2,6 +2,44 @@
 
 using namespace amrex;
 
+Real
+Castro::sdc_flux_register_weight() const
+{
+    // With K the final SDC iteration, the update over the step is
+    //
+    //   U^{n+1} = U^n + sum_{m < M-1} dt_m (A^K_m - A^{K-1}_m)
+    //                 + dt sum_m w_m A^{K-1}_m
+    //
+    // where M is the number of nodes, dt_m is the time between nodes m
+    // and m+1, and w_m are the quadrature weights.  The node 0 state
+    // never changes, so its advective term is only evaluated in the
+    // first iteration and its weight is just w_0.  The other nodes
+    // contribute w_m - dt_m / dt in the next-to-last iteration and
+    // dt_m / dt in the last.
+
+    const int m = current_sdc_node;
+    const int last_iteration = sdc_order + sdc_extra - 1;
+
+    if (m == 0) {
+        return sdc_iteration == 0 ? node_weights[0] : 0.0_rt;
+    }
+
+    const Real dt_frac = (m < SDC_NODES-1) ? dt_sdc[m+1] - dt_sdc[m] : 0.0_rt;
+
+    Real weight = 0.0_rt;
+
+    if (sdc_iteration == last_iteration - 1) {
+        weight += node_weights[m] - dt_frac;
+    }
+
+    if (sdc_iteration == last_iteration) {
+        weight += dt_frac;
+    }
+
+    return weight;
+}
+
+
 void
 Castro::ca_sdc_update_advection_o2_lobatto(const Box& bx,
                                            Real dt_m, Real dt,
@@ -1,4 +1,5 @@
 #include "Castro.H"
+#include <local_sources.H>
 
 using namespace amrex;
 
@@ -135,16 +136,7 @@ Castro::fill_geom_source ([[maybe_unused]] Real time, [[maybe_unused]] Real dt,
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-
-      // radius for non-Cartesian
-      Real r = prob_lo[0] + (static_cast<Real>(i) + 0.5_rt)*dx[0];
-
-      // radial momentum: F = rho v_phi**2 / r
-      src(i,j,k,UMX) = U_arr(i,j,k,UMZ) * U_arr(i,j,k,UMZ) / (U_arr(i,j,k,URHO) * r);
-
-      // azimuthal momentum: F = - rho v_r v_phi / r
-      src(i,j,k,UMZ) = - U_arr(i,j,k,UMX) * U_arr(i,j,k,UMZ) / (U_arr(i,j,k,URHO) * r);
-
+      geom_source_zone(i, j, k, U_arr, dx, prob_lo, src(i,j,k,UMX), src(i,j,k,UMZ));
     });
   }
 }
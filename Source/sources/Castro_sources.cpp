@@ -1,9 +1,22 @@
 #include <Castro.H>
+#include <local_sources.H>
 
 #ifdef RADIATION
 #include <Radiation.H>
 #endif
 
+#ifdef HYBRID_MOMENTUM
+#include <hybrid.H>
+#endif
+
+#ifdef GRAVITY
+#include <gravity_sources.H>
+#endif
+
+#ifdef ROTATION
+#include <rotation_sources.H>
+#endif
+
 using namespace amrex;
 
 void
@@ -127,8 +140,38 @@ Castro::do_old_sources(
         return;
     }
 
-    for (int n = 0; n < num_src; ++n) {
-        construct_old_source(n, source, state_old, time, dt);
+    if (fuse_sources == 1) {
+
+        // Gather runs of consecutive point-local sources and evaluate
+        // each run in a single pass.  Everything else is constructed
+        // on its own, in between, so the sources are still accumulated
+        // in the same order as the unfused path.
+
+        Vector<int> fused;
+
+        for (int n = 0; n < num_src; ++n) {
+            if (old_source_is_local(n)) {
+                fused.push_back(n);
+            }
+            else if (!old_source_is_noop(n)) {
+                if (!fused.empty()) {
+                    construct_old_local_sources(fused, source, state_old, time, dt);
+                    fused.clear();
+                }
+                construct_old_source(n, source, state_old, time, dt);
+            }
+        }
+
+        if (!fused.empty()) {
+            construct_old_local_sources(fused, source, state_old, time, dt);
+        }
+
+    } else {
+
+        for (int n = 0; n < num_src; ++n) {
+            construct_old_source(n, source, state_old, time, dt);
+        }
+
     }
 
     if (apply_to_state) {
@@ -341,6 +384,222 @@ Castro::construct_old_source(int src, MultiFab& source, MultiFab& state_in, Real
     } // end switch
 }
 
+bool
+Castro::old_source_is_local(int src)
+{
+    // The old-time sources that only need the state in a zone (and
+    // its immediate neighbors) and that are active for this run.
+
+    switch(src) {
+
+    case thermo_src:
+        return source_flag(thermo_src);
+
+    case geom_src:
+        return geom.Coord() == 1 && use_axisymmetric_geom_source == 1;
+
+#ifdef HYBRID_MOMENTUM
+    case hybrid_src:
+        return true;
+#endif
+
+#ifdef GRAVITY
+    case grav_src:
+        return do_grav;
+#endif
+
+#ifdef ROTATION
+    case rot_src:
+        return do_rotation;
+#endif
+
+    default:
+        return false;
+
+    } // end switch
+}
+
+bool
+Castro::old_source_is_noop(int src)
+{
+    // The old-time sources for which construct_old_source does nothing.
+
+    switch(src) {
+
+    case thermo_src:
+        return !source_flag(thermo_src);
+
+    case geom_src:
+        return !(geom.Coord() == 1 && use_axisymmetric_geom_source == 1);
+
+    case ext_src:
+        return !add_ext_src;
+
+#ifdef SPONGE
+    case sponge_src:
+        // We do not apply any sponge at the old time.
+        return true;
+#endif
+
+#ifdef DIFFUSION
+    case diff_src:
+        return time_integration_method == SpectralDeferredCorrections;
+#endif
+
+#ifdef GRAVITY
+    case grav_src:
+        return !do_grav;
+#endif
+
+#ifdef ROTATION
+    case rot_src:
+        return !do_rotation;
+#endif
+
+    default:
+        return false;
+
+    } // end switch
+}
+
+void
+Castro::construct_old_local_sources(const Vector<int>& srcs, MultiFab& source, MultiFab& state_in, Real time, Real dt)
+{
+    amrex::ignore_unused(time);
+
+    BL_PROFILE("Castro::construct_old_local_sources()");
+
+    const Real strt_time = ParallelDescriptor::second();
+
+    AMREX_ASSERT(srcs.size() <= num_src);
+
+    GpuArray<int, num_src> src_list{};
+    const int nlocal = static_cast<int>(srcs.size());
+    for (int n = 0; n < nlocal; ++n) {
+        src_list[n] = srcs[n];
+    }
+
+    const auto dx = geom.CellSizeArray();
+    const auto prob_lo = geom.ProbLoArray();
+    const int coord = geom.Coord();
+
+    [[maybe_unused]] GeometryData geomdata = geom.data();
+
+#ifdef GRAVITY
+    const MultiFab& grav_old = get_old_data(Gravity_Type);
+
+    AMREX_ALWAYS_ASSERT(!do_grav || (castro::grav_source_type >= 1 && castro::grav_source_type <= 4));
+#endif
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(state_in, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+
+        Array4<Real const> const uold = state_in.array(mfi);
+        Array4<Real> const source_arr = source.array(mfi);
+#ifdef GRAVITY
+        Array4<Real const> const grav = grav_old.array(mfi);
+#endif
+
+        amrex::ParallelFor(bx,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            // Each source is added exactly as its construct_old_*_source
+            // routine would add it, and in the same order, so the result
+            // is identical to evaluating the sources one at a time.
+
+            Real acc[NSRC];
+            for (int n = 0; n < NSRC; ++n) {
+                acc[n] = source_arr(i,j,k,n);
+            }
+
+            Real src[NSRC];
+
+            for (int m = 0; m < nlocal; ++m) {
+
+                const int isrc = src_list[m];
+
+                if (isrc == thermo_src) {
+
+                    for (int n = 0; n < NSRC; ++n) {
+                        src[n] = 0.0_rt;
+                    }
+                    src[UEINT] = thermo_source_zone(i, j, k, uold, dx, prob_lo, coord);
+
+                    for (int n = 0; n < NSRC; ++n) {
+                        acc[n] += src[n];
+                    }
+
+                } else if (isrc == geom_src) {
+
+                    for (int n = 0; n < NSRC; ++n) {
+                        src[n] = 0.0_rt;
+                    }
+                    geom_source_zone(i, j, k, uold, dx, prob_lo, src[UMX], src[UMZ]);
+
+                    for (int n = 0; n < NSRC; ++n) {
+                        acc[n] += src[n];
+                    }
+
+                }
+#ifdef HYBRID_MOMENTUM
+                else if (isrc == hybrid_src) {
+
+                    acc[UMR] = acc[UMR] + hybrid_hydro_source_zone(i, j, k, uold, geomdata, 1.0_rt);
+
+                }
+#endif
+#ifdef GRAVITY
+                else if (isrc == grav_src) {
+
+                    old_gravity_source_zone(i, j, k, uold, grav, dt, geomdata, src);
+
+                    for (int n = 0; n < NSRC; ++n) {
+                        acc[n] += src[n];
+                    }
+
+                }
+#endif
+#ifdef ROTATION
+                else if (isrc == rot_src) {
+
+                    old_rotation_source_zone(i, j, k, uold, dt, geomdata, src);
+
+                    for (int n = 0; n < NSRC; ++n) {
+                        acc[n] += src[n];
+                    }
+
+                }
+#endif
+
+            }
+
+            for (int n = 0; n < NSRC; ++n) {
+                source_arr(i,j,k,n) = acc[n];
+            }
+        });
+    }
+
+    if (verbose > 1)
+    {
+        const int IOProc   = ParallelDescriptor::IOProcessorNumber();
+        Real      run_time = ParallelDescriptor::second() - strt_time;
+
+#ifdef BL_LAZY
+        Lazy::QueueReduction( [=] () mutable {
+#endif
+        ParallelDescriptor::ReduceRealMax(run_time,IOProc);
+
+        amrex::Print() << "Castro::construct_old_local_sources() time = " << run_time << " on level " << level << "\n" << "\n";
+#ifdef BL_LAZY
+        });
+#endif
+    }
+}
+
 void
 Castro::construct_new_source(int src, MultiFab& source, MultiFab& state_old, MultiFab& state_new, Real time, Real dt)
 {
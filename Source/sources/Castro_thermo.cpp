@@ -1,4 +1,5 @@
 #include <Castro.H>
+#include <local_sources.H>
 
 using namespace amrex;
 
@@ -146,56 +147,7 @@ Castro::fill_thermo_source (MultiFab& state_in, MultiFab& thermo_src)
     amrex::ParallelFor(bx,
     [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
     {
-
-      // radius for non-Cartesian
-      Real rp = prob_lo[0] + (static_cast<Real>(i) + 1.5_rt)*dx[0];
-      Real rm = prob_lo[0] + (static_cast<Real>(i) - 0.5_rt)*dx[0];
-      Real r = 0.5_rt*(rm + rp);
-
-      // compute -div{U}
-      if (coord == 0) {
-        src(i,j,k,UEINT) = -0.5_rt*(U(i+1,j,k,UMX)/U(i+1,j,k,URHO)  -
-                                    U(i-1,j,k,UMX)/U(i-1,j,k,URHO))/dx[0];
-
-      } else if (coord == 1) {
-        // axisymmetric
-        src(i,j,k,UEINT) = -0.5_rt*(rp*U(i+1,j,k,UMX)/U(i+1,j,k,URHO) -
-                                    rm*U(i-1,j,k,UMX)/U(i-1,j,k,URHO))/(r*dx[0]);
-
-      } else if (coord == 2) {
-        // spherical
-        src(i,j,k,UEINT) = -0.5_rt*(rp*rp*U(i+1,j,k,UMX)/U(i+1,j,k,URHO) -
-                                    rm*rm*U(i-1,j,k,UMX)/U(i-1,j,k,URHO))/(r*r*dx[0]);
-      }
-
-#if AMREX_SPACEDIM >= 2
-      src(i,j,k,UEINT) += -0.5_rt*(U(i,j+1,k,UMY)/U(i,j+1,k,URHO) -
-                                   U(i,j-1,k,UMY)/U(i,j-1,k,URHO))/dx[1];
-#endif
-#if AMREX_SPACEDIM == 3
-      src(i,j,k,UEINT) += -0.5_rt*(U(i,j,k+1,UMZ)/U(i,j,k+1,URHO) -
-                                   U(i,j,k-1,UMZ)/U(i,j,k-1,URHO))/dx[2];
-#endif
-
-      // we now need the pressure -- we will assume that the
-      // temperature is consistent with the input state
-      eos_rep_t eos_state;
-      eos_state.rho = U(i,j,k,URHO);
-      eos_state.T = U(i,j,k,UTEMP);
-      for (int n = 0; n < NumSpec; n++) {
-        eos_state.xn[n] = U(i,j,k,UFS+n)/U(i,j,k,URHO);
-      }
-#if NAUX_NET > 0
-      for (int n = 0; n < NumAux; n++) {
-        eos_state.aux[n] = U(i,j,k,UFX+n)/U(i,j,k,URHO);
-      }
-#endif
-
-      eos(eos_input_rt, eos_state);
-
-      // final source term, -p div{U}
-      src(i,j,k,UEINT) = eos_state.p * src(i,j,k,UEINT);
-
+      src(i,j,k,UEINT) = thermo_source_zone(i, j, k, U, dx, prob_lo, coord);
     });
   }
 }
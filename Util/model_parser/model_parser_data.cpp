@@ -9,4 +9,6 @@ namespace model
 
     AMREX_GPU_MANAGED amrex::Array1D<initial_model_t, 0, NUM_MODELS-1> profile;
 
+    AMREX_GPU_MANAGED amrex::Array1D<model_table_t, 0, NUM_MODELS-1> table;
+
 }
@@ -66,4 +66,33 @@ int main(int argc, char *argv[]) {
 
     AMREX_ALWAYS_ASSERT(std::abs(dens_test - model::profile(0).state(idx_test, model::idens)) < 1.e-15_rt);
 
+    // the lookup tables should give exactly the same results as the
+    // binary search
+
+    std::cout << "testing the model lookup tables" << std::endl;
+
+    const int nsample = 10000;
+    const Real r_lo = -1.e6;
+    const Real r_hi = 4.2e9;
+
+    std::vector<int> idx_ref(nsample);
+    std::vector<Real> dens_ref(nsample);
+
+    for (int n = 0; n < nsample; ++n) {
+        Real r_s = r_lo + (r_hi - r_lo) * n / (nsample - 1);
+        idx_ref[n] = locate(r_s, 0);
+        dens_ref[n] = interpolate(r_s, model::idens);
+    }
+
+    for (bool log_spacing : {false, true}) {
+        build_model_table(0, log_spacing);
+        AMREX_ALWAYS_ASSERT(model::table(0).nbins > 0);
+
+        for (int n = 0; n < nsample; ++n) {
+            Real r_s = r_lo + (r_hi - r_lo) * n / (nsample - 1);
+            AMREX_ALWAYS_ASSERT(locate(r_s, 0) == idx_ref[n]);
+            AMREX_ALWAYS_ASSERT(interpolate(r_s, model::idens) == dens_ref[n]);
+        }
+    }
+
 }
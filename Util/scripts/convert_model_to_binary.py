@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+
+"""Convert an ASCII initial model, in the format read by
+Util/model_parser/model_parser.H, to the equivalent binary format, which
+read_model_file() recognizes by its magic string.  The binary model is
+exact (no decimal round trip) and much faster to read for large models.
+
+The binary file contains the magic string "CASTROMD", then a byte-order
+mark, the format version, the number of points, the number of variables,
+and the name of each variable (its length and then its characters), all as
+32-bit unsigned integers.  Then, for each point, the coordinate and the
+variables follow as 64-bit floats.
+
+usage: convert_model_to_binary.py model_file [binary_file]
+
+If binary_file is not given, it is model_file with ".bin" appended.
+"""
+
+import argparse
+import sys
+
+import numpy as np
+
+MODEL_MAGIC = b"CASTROMD"
+MODEL_VERSION = 1
+BYTE_ORDER_MARK = 0x01020304
+
+
+def read_ascii_model(model_file):
+    """Read an ASCII initial model, returning the variable names and an
+    array of shape (npts, 1 + nvars) holding the coordinate and the
+    variables at each point."""
+
+    with open(model_file) as f:
+        npts = int(f.readline().split("=")[1])
+        nvars = int(f.readline().split("=")[1])
+        names = [f.readline().split("#", 1)[1].strip() for _ in range(nvars)]
+
+        # the data may be laid out over any number of lines, so read it
+        # as one stream of numbers, like the C++ reader does
+        values = np.array(f.read().replace("D", "E").replace("d", "e").split(),
+                          dtype=np.float64)
+
+    if values.size < npts * (nvars + 1):
+        sys.exit(f"error: {model_file} has fewer than {npts} points")
+
+    return names, values[:npts * (nvars + 1)].reshape(npts, nvars + 1)
+
+
+def write_binary_model(binary_file, names, data):
+    """Write a model in the binary format read by read_model_file()."""
+
+    npts, ncols = data.shape
+    assert ncols == len(names) + 1
+
+    with open(binary_file, "wb") as f:
+        f.write(MODEL_MAGIC)
+        np.array([BYTE_ORDER_MARK, MODEL_VERSION, npts, len(names)],
+                 dtype=np.uint32).tofile(f)
+        for name in names:
+            encoded = name.encode()
+            np.array([len(encoded)], dtype=np.uint32).tofile(f)
+            f.write(encoded)
+        np.ascontiguousarray(data, dtype=np.float64).tofile(f)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="convert an ASCII initial model to binary")
+    parser.add_argument("model_file", help="the ASCII initial model")
+    parser.add_argument("binary_file", nargs="?", help="the binary model to write")
+    args = parser.parse_args()
+
+    binary_file = args.binary_file or args.model_file + ".bin"
+
+    names, data = read_ascii_model(args.model_file)
+    write_binary_model(binary_file, names, data)
+
+    print(f"wrote {data.shape[0]} points and {len(names)} variables to {binary_file}")
+
+
+if __name__ == "__main__":
+    main()
@@ -11,6 +11,9 @@ To use these in a standalone script, you can do one of the following:
 * copy this file into the same directory as your script
 
 Then you can do `from diag_parser import read_diag_file`.
+
+The binary logs written with castro.diag_log_format = 1 or 2 (*_diag.bin) can
+be read with `read_binary_diag_file`, which returns the same kind of array.
 """
 
 from pathlib import Path
@@ -102,6 +105,53 @@ def read_diag_file(file_path, dedupe=True):
     return data
 
 
+BINARY_MAGIC = b"CASTRODL"
+BINARY_VERSION = 1
+
+
+def read_binary_diag_file(file_path, dedupe=True):
+    """Reads a binary Castro diagnostic file (*_diag.bin) into a numpy
+    structured array.
+
+    The file has a header giving the type and name of each column (see
+    Source/driver/binary_diag_log.H), followed by fixed-size rows of 8-byte
+    values. A partially written row at the end of the file is ignored.
+    """
+    with open(file_path, "rb") as f:
+        buf = f.read()
+
+    if buf[:8] != BINARY_MAGIC:
+        raise ValueError(f"{file_path} is not a Castro binary diagnostic file")
+
+    # the byte-order mark tells us the endianness the file was written with
+    bom = int(np.frombuffer(buf, dtype="<u4", count=1, offset=8)[0])
+    byteorder = "<" if bom == 0x01020304 else ">"
+
+    version, num_columns = np.frombuffer(buf, dtype=byteorder + "u4", count=2, offset=12)
+    if version != BINARY_VERSION:
+        raise ValueError(f"unsupported binary diagnostic file version {version}")
+
+    offset = 20
+    names = []
+    formats = []
+    for _ in range(num_columns):
+        column_type = buf[offset]
+        offset += 1
+        name_length = int(np.frombuffer(buf, dtype=byteorder + "u4", count=1, offset=offset)[0])
+        offset += 4
+        names.append(buf[offset:offset + name_length].decode())
+        offset += name_length
+        formats.append(byteorder + ("i8" if column_type == 0 else "f8"))
+
+    dtype = np.dtype({"names": names, "formats": formats})
+    num_rows = (len(buf) - offset) // dtype.itemsize
+    data = np.frombuffer(buf, dtype=dtype, count=num_rows, offset=offset).copy()
+
+    if dedupe:
+        data = deduplicate(data)
+    return data
+
+
 def deduplicate(data):
     """Deduplicate based on the timestep, keeping the only last occurrence."""
     # get the unique indices into the reversed timestep array, so we find the
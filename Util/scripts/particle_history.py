@@ -0,0 +1,116 @@
+"""Helper functions for reading the binary tracer particle history written with
+particles.timestamp_format = 1 (timestamp_dir/History*_NN, with the index
+timestamp_dir/History*.idx)
+
+To use these in a standalone script, append $CASTRO_HOME/Util/scripts to
+sys.path, or copy or symlink this file next to your script, then do
+`from particle_history import read_history_file`.
+"""
+
+import re
+from pathlib import Path
+
+import numpy as np
+
+HISTORY_MAGIC = b"CASTROPH"
+HISTORY_VERSION = 1
+
+# step, level, time, number of records
+BLOCK_HEADER_BYTES = 32
+
+
+def read_history_header(buf, file_path=""):
+    """Parse the header of a particle history data file, returning the numpy
+    dtype of a record and the offset of the first block."""
+    if buf[:8] != HISTORY_MAGIC:
+        raise ValueError(f"{file_path} is not a Castro particle history file")
+
+    # the byte-order mark tells us the endianness the file was written with
+    bom = int(np.frombuffer(buf, dtype="<u4", count=1, offset=8)[0])
+    byteorder = "<" if bom == 0x01020304 else ">"
+
+    version, num_columns, record_bytes = np.frombuffer(
+        buf, dtype=byteorder + "u4", count=3, offset=12)
+    if version != HISTORY_VERSION:
+        raise ValueError(f"unsupported particle history file version {version}")
+
+    offset = 24
+    names = ["id", "cpu"]
+    for _ in range(num_columns):
+        name_length = int(np.frombuffer(buf, dtype=byteorder + "u4", count=1, offset=offset)[0])
+        offset += 4
+        names.append(buf[offset:offset + name_length].decode())
+        offset += name_length
+
+    formats = [byteorder + "i8"] * 2 + [byteorder + "f8"] * int(num_columns)
+    dtype = np.dtype({"names": names, "formats": formats})
+    assert dtype.itemsize == record_bytes
+
+    return dtype, byteorder, offset
+
+
+def read_history_file(file_path):
+    """Read one particle history data file (History*_NN) into a numpy
+    structured array, with the step, level, and time of each record added
+    as columns.
+
+    The blocks are read in the order they were written; a partially written
+    block at the end of the file is ignored.
+    """
+    with open(file_path, "rb") as f:
+        buf = f.read()
+
+    dtype, byteorder, offset = read_history_header(buf, file_path)
+
+    header_dtype = np.dtype([("step", byteorder + "i8"), ("level", byteorder + "i8"),
+                             ("time", byteorder + "f8"), ("nrec", byteorder + "i8")])
+
+    out_dtype = np.dtype([("step", "i8"), ("level", "i8"), ("time", "f8")] +
+                         [(name, dtype.fields[name][0]) for name in dtype.names])
+
+    chunks = []
+    while offset + BLOCK_HEADER_BYTES <= len(buf):
+        header = np.frombuffer(buf, dtype=header_dtype, count=1, offset=offset)[0]
+        nrec = int(header["nrec"])
+        offset += BLOCK_HEADER_BYTES
+        if offset + nrec * dtype.itemsize > len(buf):
+            break
+
+        records = np.frombuffer(buf, dtype=dtype, count=nrec, offset=offset)
+        offset += nrec * dtype.itemsize
+
+        chunk = np.empty(nrec, dtype=out_dtype)
+        chunk["step"] = header["step"]
+        chunk["level"] = header["level"]
+        chunk["time"] = header["time"]
+        for name in dtype.names:
+            chunk[name] = records[name]
+        chunks.append(chunk)
+
+    if not chunks:
+        return np.empty(0, dtype=out_dtype)
+    return np.concatenate(chunks)
+
+
+def read_history(basename):
+    """Read all of the data files of a particle history (e.g.
+    "particle_dir/History" or "particle_dir/History_0000100"), sorted by
+    time and then by particle."""
+    basename = Path(basename)
+    pattern = re.compile(re.escape(basename.name) + r"_\d+")
+    files = sorted(f for f in basename.parent.iterdir() if pattern.fullmatch(f.name))
+    data = [read_history_file(f) for f in files]
+    if not data:
+        raise FileNotFoundError(f"no particle history files match {basename}_NN")
+    data = np.concatenate(data)
+    return data[np.lexsort((data["id"], data["cpu"], data["time"]))]
+
+
+def read_history_index(basename):
+    """Read the index (<basename>.idx) of a particle history: one row per
+    block of records, giving its step, level, time, rank, data file number,
+    byte offset, and number of records."""
+    return np.loadtxt(str(basename) + ".idx", comments="#",
+                      dtype=[("step", "i8"), ("level", "i8"), ("time", "f8"),
+                             ("rank", "i8"), ("file", "i8"), ("offset", "i8"),
+                             ("nrec", "i8")], ndmin=1)